@@ -20,6 +20,11 @@
 #include "miniSG/miniSG.h"
 // ospray, for rendering
 #include "ospray/ospray.h"
+// system, for benchmark memory statistics
+#include <algorithm>
+#ifndef _WIN32
+# include <sys/resource.h>
+#endif
 
 namespace ospray {
   using std::cout;
@@ -39,6 +44,8 @@ namespace ospray {
   int g_benchWarmup = 0, g_benchFrames = 0;
   bool g_alpha = false;
   bool g_createDefaultMaterial = true;
+  //! BVH build mode of the models, use '--bvh-build-mode <default|fast|high_quality|compact>' to change
+  std::string g_bvhBuildMode = "default";
   int accumID = -1;
   int maxAccum = 64;
   int spp = 1; /*! number of samples per pixel */
@@ -69,7 +76,7 @@ namespace ospray {
     cout << "#ospModelViewer fatal error : " << msg << endl;
     cout << endl;
     cout << "Proper usage: " << endl;
-    cout << "  ./ospModelViewer [-bench <warmpup>x<numFrames>] [-model] <inFileName>" << endl;
+    cout << "  ./ospModelViewer [-bench <warmpup>x<numFrames>] [--bvh-build-mode <default|fast|high_quality|compact>] [-model] <inFileName>" << endl;
     cout << endl;
     exit(1);
   }
@@ -290,6 +297,10 @@ namespace ospray {
           double time = ospray::getSysTime()-benchStart;
           double avgFps = fpsSum/double(frameID-g_benchWarmup);
           printf("Benchmark: time: %f avg fps: %f avg frame time: %f\n", time, avgFps, time/double(frameID-g_benchWarmup));
+          // derived from the frame rate, so this includes shading, frame
+          // buffer and display overhead and is not a pure trace rate
+          printf("Benchmark: bvh build mode: %s frame throughput: %f Msamples/s\n", g_bvhBuildMode.c_str(),
+                 avgFps * g_windowSize.x * g_windowSize.y * std::max(spp, 1) * 1e-6);
 
           const uint32 * p = (uint32*)ospMapFrameBuffer(fb, OSP_FB_COLOR);
           writePPM("benchmark.ppm", g_windowSize.x, g_windowSize.y, p);
@@ -552,6 +563,9 @@ namespace ospray {
                 ss >> g_benchWarmup >> g_benchFrames;
               }
           }
+      } else if (arg == "--bvh-build-mode") {
+        assert(i+1 < ac);
+        g_bvhBuildMode = av[++i];
       } else if (arg == "--no-default-material") {
         g_createDefaultMaterial = false;
       } else if (av[i][0] == '-') {
@@ -771,6 +785,7 @@ namespace ospray {
       if (doesInstancing) {
         OSPModel model_i = ospNewModel();
         ospAddGeometry(model_i,ospMesh);
+        ospSetString(model_i,"bvhBuildMode",g_bvhBuildMode.c_str());
         ospCommit(model_i);
         instanceModels.push_back(model_i);
       } else
@@ -786,8 +801,26 @@ namespace ospray {
       }
     }
     cout << "#ospModelViewer: committing model" << endl;
+    ospSetString(ospModel,"bvhBuildMode",g_bvhBuildMode.c_str());
+    const double buildStart = ospray::getSysTime();
     ospCommit(ospModel);
+    const double buildTime = ospray::getSysTime() - buildStart;
     cout << "#ospModelViewer: done creating ospray model." << endl;
+    if (g_benchFrames > 0) {
+      // peak resident memory of the process, including the model data and acceleration structures
+      double peakMemory = 0.0;
+#if defined(__APPLE__)
+      struct rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+      peakMemory = usage.ru_maxrss / (1024.0 * 1024.0);
+#elif !defined(_WIN32)
+      struct rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+      peakMemory = usage.ru_maxrss / 1024.0;
+#endif
+      printf("Benchmark: bvh build mode: %s build time: %f peak memory: %.1f MB\n",
+             g_bvhBuildMode.c_str(), buildTime, peakMemory);
+    }
 
     //TODO: Need to figure out where we're going to read lighting data from
     //begin light test
@@ -30,6 +30,8 @@ namespace ospray {
 
   const char *rendererType = "raycast_eyelight";
   bool doShadows = 1;
+  //! intersect stream lines and cylinders as embree hair curves ('--hair')
+  bool useHair = false;
 
   OSPModel model = NULL;
 
@@ -508,6 +510,7 @@ namespace ospray {
         ospSetObject(geom,"vertex",vertex);
         ospSetObject(geom,"index",index);
         ospSet1f(geom,"radius",sl->radius);
+        ospSet1i(geom,"hair",useHair);
         if (mat)
           ospSetMaterial(geom,mat);
         ospCommit(geom);
@@ -563,6 +566,7 @@ namespace ospray {
 
           data = ospNewData(swc->cylinders[i].size()*7, OSP_FLOAT, &swc->cylinders[i][0]);
           ospSetObject(cylinders[i], "cylinders", data);
+          ospSet1i(cylinders[i], "hair", useHair);
  
           if (material[i])
             ospSetMaterial(cylinders[i], material[i]);
@@ -572,7 +576,11 @@ namespace ospray {
         }
       }
 
+      // report the BVH build time, to compare the hair and user geometry paths
+      const double buildStart = ospray::getSysTime();
       ospCommit(model);
+      cout << "#osp:slv: model build time " << (ospray::getSysTime() - buildStart)
+           << " s (" << (useHair ? "hair curves" : "user geometry") << ")" << endl;
 
       Assert2(renderer,"could not create renderer");
       ospSetObject(renderer,"world",model);
@@ -677,6 +685,8 @@ namespace ospray {
         ospLoadModule(av[++i]);
       } else if (arg == "--renderer") {
         rendererType = av[++i];
+      } else if (arg == "--hair") {
+        useHair = true;
       } else if (arg == "--radius") {
         streamLines->radius = atof(av[++i]);
       } else if (arg == "--export") {
@@ -123,8 +123,11 @@ void VolumeViewer::addGeometry(std::string filename)
   // Attempt to load the geometry through the TriangleMeshFile loader.
   OSPTriangleMesh triangleMesh = ospNewTriangleMesh();
 
+  // The loader may return another geometry in place of the triangle mesh (e.g. a heightfield).
+  triangleMesh = TriangleMeshFile::importTriangleMesh(filename, triangleMesh);
+
   // If successful, commit the triangle mesh and add it to all models.
-  if(TriangleMeshFile::importTriangleMesh(filename, triangleMesh) != NULL) {
+  if(triangleMesh != NULL) {
 
     // For now: if this is a DDS geometry, assume it is a horizon and its color should be mapped through the first volume's transfer function.
     if(QString(filename.c_str()).endsWith(".dds") && modelStates.size() > 0 && modelStates[0].volumes.size() > 0) {
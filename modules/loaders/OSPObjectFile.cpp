@@ -177,6 +177,9 @@ OSPTriangleMesh OSPObjectFile::importTriangleMesh(const tinyxml2::XMLNode *root)
     // Scaling for vertex coordinates.
     if (!strcmp(node->ToElement()->Name(), "scale")) { importAttributeFloat3(node, triangleMesh);  continue; }
 
+    // Request a heightfield geometry instead of a triangle mesh from loaders that support it.
+    if (!strcmp(node->ToElement()->Name(), "heightfield")) { importAttributeInteger(node, triangleMesh);  continue; }
+
     // Error check.
     exitOnCondition(true, "unrecognized XML element type '" + std::string(node->ToElement()->Name()) + "'");
   }
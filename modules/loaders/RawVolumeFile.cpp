@@ -134,3 +134,45 @@ OSPVolume RawVolumeFile::importVolume(OSPVolume volume)
   // Return the volume.
   return(volume);
 }
+
+void RawVolumeFile::readVoxels(int offset, const osp::vec3i &volumeDimensions, size_t voxelSize,
+                               const osp::vec3i &subvolumeOffsets, const osp::vec3i &subvolumeDimensions, const osp::vec3i &subvolumeSteps,
+                               std::vector<unsigned char> &voxels)
+{
+  // Look for the volume data file at the given path.
+  FILE *file = fopen(filename.c_str(), "rb");  exitOnCondition(!file, "unable to open file '" + filename + "'");
+
+  // The dimensions of the volume to be imported, considering the subvolume specified.
+  const osp::vec3i importVolumeDimensions(subvolumeDimensions.x / subvolumeSteps.x + (subvolumeDimensions.x % subvolumeSteps.x != 0),
+                                          subvolumeDimensions.y / subvolumeSteps.y + (subvolumeDimensions.y % subvolumeSteps.y != 0),
+                                          subvolumeDimensions.z / subvolumeSteps.z + (subvolumeDimensions.z % subvolumeSteps.z != 0));
+
+  voxels.resize(size_t(importVolumeDimensions.x) * importVolumeDimensions.y * importVolumeDimensions.z * voxelSize);
+
+  // Allocate memory for a single row of voxel data.
+  std::vector<unsigned char> rowData(volumeDimensions.x * voxelSize);
+
+  // Read the subvolume data from the full volume, row by row.
+  size_t voxelOffset = 0;
+  for(long i3=subvolumeOffsets.z; i3<subvolumeOffsets.z+subvolumeDimensions.z; i3+=subvolumeSteps.z) {
+
+    for(long i2=subvolumeOffsets.y; i2<subvolumeOffsets.y+subvolumeDimensions.y; i2+=subvolumeSteps.y) {
+
+      // Seek to appropriate location in file.
+      fseek(file, offset + (i3 * volumeDimensions.y + i2) * volumeDimensions.x * voxelSize, SEEK_SET);
+
+      // Read row from volume.
+      size_t voxelsRead = fread(&rowData[0], voxelSize, volumeDimensions.x, file);
+
+      // The end of the file may have been reached unexpectedly.
+      exitOnCondition(voxelsRead != volumeDimensions.x, "end of volume file reached before read completed");
+
+      // Resample row for the subvolume.
+      for(long i1=subvolumeOffsets.x; i1<subvolumeOffsets.x+subvolumeDimensions.x; i1+=subvolumeSteps.x, voxelOffset+=voxelSize)
+        memcpy(&voxels[voxelOffset], &rowData[i1 * voxelSize], voxelSize);
+    }
+  }
+
+  // Clean up.
+  fclose(file);
+}
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "modules/loaders/VolumeFile.h"
 
 //! \brief A concrete implementation of the VolumeFile class for reading
@@ -35,6 +36,11 @@ public:
   //! Import the volume data.
   virtual OSPVolume importVolume(OSPVolume volume);
 
+  //! Read the voxel data of the given (sub)volume into a buffer without accessing any OSPRay object, so this may be called on any thread.
+  void readVoxels(int offset, const osp::vec3i &volumeDimensions, size_t voxelSize,
+                  const osp::vec3i &subvolumeOffsets, const osp::vec3i &subvolumeDimensions, const osp::vec3i &subvolumeSteps,
+                  std::vector<unsigned char> &voxels);
+
   //! A string description of this class.
   virtual std::string toString() const { return("ospray_module_loaders::RawVolumeFile"); }
 
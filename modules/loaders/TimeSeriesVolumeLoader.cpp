@@ -0,0 +1,207 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+#include "modules/loaders/TimeSeriesVolumeLoader.h"
+#include "modules/loaders/RawVolumeFile.h"
+
+TimeSeriesVolumeLoader::TimeSeriesVolumeLoader(OSPVolume volume, const std::vector<std::string> &filenames, size_t windowSize)
+  : volume(volume), filenames(filenames), windowSize(std::max(windowSize, size_t(1))), importing(-1), shutdown(false)
+{
+  exitOnCondition(filenames.empty(), "no timestep files specified");
+
+  // Only raw voxel files can be read without creating OSPRay objects on the background thread.
+  for (size_t i=0 ; i < filenames.size() ; i++)
+    exitOnCondition(filenames[i].substr(filenames[i].find_last_of(".") + 1) != "raw", "timestep '" + filenames[i] + "' is not a raw volume file");
+
+  // The background thread only reads this copy, the time series volume may be modified by the application meanwhile.
+  getTimestepParameters();
+
+  // Read timesteps in the background while the application renders.
+  thread = embree::createThread(threadFunction, this);
+}
+
+TimeSeriesVolumeLoader::~TimeSeriesVolumeLoader()
+{
+  // Stop the background thread after the current read completes.
+  mutex.lock();  shutdown = true;  queue.clear();  condition.broadcast();  mutex.unlock();
+  embree::join(thread);
+
+  // Release the resident timesteps, the current one is still referenced by the time series volume.
+  for (std::map<size_t, OSPVolume>::iterator it = resident.begin() ; it != resident.end() ; ++it)
+    ospRelease(it->second);
+}
+
+void TimeSeriesVolumeLoader::setTimestep(size_t index)
+{
+  exitOnCondition(index >= filenames.size(), "invalid timestep index");
+
+  // The window holds the requested timestep and the following ones, wrapping around for animation loops.
+  std::vector<size_t> window;
+  for (size_t i=0 ; i < std::min(windowSize, filenames.size()) ; i++) window.push_back((index + i) % filenames.size());
+
+  std::vector<unsigned char> voxels;
+
+  mutex.lock();
+
+  if (resident.count(index) == 0) {
+
+    // Read the requested timestep next if it is neither read nor being read.
+    if (loaded.count(index) == 0 && importing != ssize_t(index)) {
+      queue.push_front(index);
+      condition.broadcast();
+    }
+
+    // Wait for the voxel data of the requested timestep.
+    while (loaded.count(index) == 0) condition.wait(mutex);
+    voxels.swap(loaded[index]);  loaded.erase(index);
+  }
+
+  // Drop voxel data outside the window.
+  for (std::map<size_t, std::vector<unsigned char> >::iterator it = loaded.begin() ; it != loaded.end() ; ) {
+    if (std::find(window.begin(), window.end(), it->first) == window.end()) loaded.erase(it++);
+    else ++it;
+  }
+
+  // Queue the missing timesteps of the window for reading, in order.
+  queue.clear();
+  for (size_t i=1 ; i < window.size() ; i++)
+    if (resident.count(window[i]) == 0 && loaded.count(window[i]) == 0 && importing != ssize_t(window[i])) queue.push_back(window[i]);
+  condition.broadcast();
+
+  mutex.unlock();
+
+  // The OSPRay objects are only created and released on the calling thread.
+  if (resident.count(index) == 0) resident[index] = createTimestep(voxels);
+  OSPVolume timestep = resident[index];
+
+  // Render the timestep, the model and the other timesteps are left untouched.
+  ospSetObject(volume, "timestepVolume", timestep);
+  ospCommit(volume);
+
+  // Release resident timesteps outside the window.
+  for (std::map<size_t, OSPVolume>::iterator it = resident.begin() ; it != resident.end() ; ) {
+    if (std::find(window.begin(), window.end(), it->first) == window.end()) {
+      ospRelease(it->second);  resident.erase(it++);
+    } else ++it;
+  }
+}
+
+void TimeSeriesVolumeLoader::getTimestepParameters()
+{
+  // The volume type used for each timestep.
+  char *type = NULL;  ospGetString(volume, "timestepVolumeType", &type);
+  timestepVolumeType = type != NULL ? type : "block_bricked_volume";
+  if (type != NULL) free(type);
+
+  // The layout of the voxel data in each timestep file.
+  filenameOffset = 0;  ospGeti(volume, "filename offset", &filenameOffset);
+  exitOnCondition(!ospGetVec3i(volume, "dimensions", &fileDimensions), "no volume dimensions specified");
+
+  char *voxelTypeValue = NULL;
+  exitOnCondition(!ospGetString(volume, "voxelType", &voxelTypeValue), "no voxel type specified");
+  voxelType = voxelTypeValue;  free(voxelTypeValue);
+  exitOnCondition(voxelType != "float" && voxelType != "uchar", "unsupported voxel type");
+  voxelSize = voxelType == "float" ? sizeof(float) : sizeof(unsigned char);
+
+  // The subvolume to import, defaulting to the full volume, see RawVolumeFile.
+  subvolumeOffsets = osp::vec3i(0);  ospGetVec3i(volume, "subvolumeOffsets", &subvolumeOffsets);
+  exitOnCondition(reduce_min(subvolumeOffsets) < 0 || reduce_max(subvolumeOffsets - fileDimensions) >= 0, "invalid subvolume offsets");
+
+  subvolumeDimensions = fileDimensions - subvolumeOffsets;  ospGetVec3i(volume, "subvolumeDimensions", &subvolumeDimensions);
+  exitOnCondition(reduce_min(subvolumeDimensions) < 1 || reduce_max(subvolumeDimensions - (fileDimensions - subvolumeOffsets)) > 0, "invalid subvolume dimension(s) specified");
+
+  subvolumeSteps = osp::vec3i(1);  ospGetVec3i(volume, "subvolumeSteps", &subvolumeSteps);
+  exitOnCondition(reduce_min(subvolumeSteps) < 1 || reduce_max(subvolumeSteps - (fileDimensions - subvolumeOffsets)) >= 0, "invalid subvolume steps");
+
+  // The dimensions of each timestep volume.
+  dimensions = osp::vec3i(subvolumeDimensions.x / subvolumeSteps.x + (subvolumeDimensions.x % subvolumeSteps.x != 0),
+                          subvolumeDimensions.y / subvolumeSteps.y + (subvolumeDimensions.y % subvolumeSteps.y != 0),
+                          subvolumeDimensions.z / subvolumeSteps.z + (subvolumeDimensions.z % subvolumeSteps.z != 0));
+
+  // The grid shared by all timesteps.
+  osp::vec3f vec3fValue;
+  const char *vec3fNames[] = { "gridOrigin", "gridSpacing" };
+  for (size_t i=0 ; i < sizeof(vec3fNames) / sizeof(vec3fNames[0]) ; i++)
+    if (ospGetVec3f(volume, vec3fNames[i], &vec3fValue)) vec3fParameters[vec3fNames[i]] = vec3fValue;
+
+  // The sampling parameters are needed to build the space skipping structure of each timestep.
+  transferFunction = NULL;
+  ospGetObject(volume, "transferFunction", &transferFunction);
+
+  samplingRate = 1.0f;
+  hasSamplingRate = ospGetf(volume, "samplingRate", &samplingRate);
+}
+
+void TimeSeriesVolumeLoader::readTimestep(size_t index, std::vector<unsigned char> &voxels) const
+{
+  RawVolumeFile file(filenames[index]);
+  file.readVoxels(filenameOffset, fileDimensions, voxelSize, subvolumeOffsets, subvolumeDimensions, subvolumeSteps, voxels);
+}
+
+OSPVolume TimeSeriesVolumeLoader::createTimestep(const std::vector<unsigned char> &voxels) const
+{
+  OSPVolume timestep = ospNewVolume(timestepVolumeType.c_str());
+  exitOnCondition(timestep == NULL, "unable to create the timestep volume");
+
+  // The volume specification shared by all timesteps.
+  ospSetVec3i(timestep, "dimensions", dimensions);
+  ospSetString(timestep, "voxelType", voxelType.c_str());
+
+  for (std::map<std::string, osp::vec3f>::const_iterator it = vec3fParameters.begin() ; it != vec3fParameters.end() ; ++it)
+    ospSetVec3f(timestep, it->first.c_str(), it->second);
+
+  if (transferFunction != NULL) ospSetObject(timestep, "transferFunction", transferFunction);
+  if (hasSamplingRate) ospSet1f(timestep, "samplingRate", samplingRate);
+
+  // Copy the voxel data and complete the volume.
+  ospSetRegion(timestep, (void *) &voxels[0], osp::vec3i(0), dimensions);
+  ospCommit(timestep);
+
+  return(timestep);
+}
+
+void TimeSeriesVolumeLoader::threadFunction(void *_loader)
+{
+  TimeSeriesVolumeLoader *loader = (TimeSeriesVolumeLoader *) _loader;
+
+  loader->mutex.lock();
+
+  while (true) {
+
+    // Wait for a timestep to read.
+    while (loader->queue.empty() && !loader->shutdown) loader->condition.wait(loader->mutex);
+    if (loader->shutdown) break;
+
+    // Read the timestep without holding the lock, the application may render and request timesteps meanwhile.
+    const size_t index = loader->queue.front();  loader->queue.pop_front();
+    loader->importing = index;
+    loader->mutex.unlock();
+
+    std::vector<unsigned char> voxels;
+    loader->readTimestep(index, voxels);
+
+    // Hand the voxel data to the calling thread.
+    loader->mutex.lock();
+    loader->importing = -1;
+    loader->loaded[index].swap(voxels);
+    loader->condition.broadcast();
+  }
+
+  loader->mutex.unlock();
+}
@@ -0,0 +1,126 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include "common/sys/thread.h"
+#include "common/sys/sync/condition.h"
+#include "common/sys/sync/mutex.h"
+#include "ospray/include/ospray/ospray.h"
+
+//! \brief Keeps a window of timesteps of a time-varying volume
+//!  resident, reading the voxels of upcoming timesteps on a background
+//!  thread.
+//!
+//!  The volume specification shared by all timesteps (dimensions,
+//!  voxelType, gridOrigin, ...) and the sampling parameters are read
+//!  from the given "time_series_volume" object.  The background thread
+//!  only reads the raw voxel data of each timestep file into memory, it
+//!  never calls the OSPRay API, which is not thread safe.  The volume of
+//!  a timestep, of the type given by the "timestepVolumeType" parameter
+//!  (block_bricked_volume by default), is created and committed on the
+//!  calling thread when the timestep is requested.  Timesteps leaving
+//!  the window are released.
+//!
+class TimeSeriesVolumeLoader {
+public:
+
+  //! Constructor.
+  TimeSeriesVolumeLoader(OSPVolume volume, const std::vector<std::string> &filenames, size_t windowSize = 3);
+
+  //! Destructor.
+  ~TimeSeriesVolumeLoader();
+
+  //! The number of timesteps.
+  size_t getTimestepCount() const { return(filenames.size()); }
+
+  //! Render the given timestep, waiting for its import if not yet resident, and prefetch the following timesteps.
+  void setTimestep(size_t index);
+
+  //! A string description of this class.
+  std::string toString() const { return("ospray_module_loaders::TimeSeriesVolumeLoader"); }
+
+private:
+
+  //! The time series volume.
+  OSPVolume volume;
+
+  //! The volume specification shared by all timesteps, read from the time series volume before the background thread starts.
+  std::string timestepVolumeType;
+  std::map<std::string, osp::vec3f> vec3fParameters;
+  std::string voxelType;  size_t voxelSize;
+  int filenameOffset;
+  osp::vec3i fileDimensions;
+  osp::vec3i subvolumeOffsets, subvolumeDimensions, subvolumeSteps;
+  osp::vec3i dimensions;
+  OSPObject transferFunction;
+  bool hasSamplingRate;  float samplingRate;
+
+  //! Paths to the files containing the voxel data of each timestep.
+  std::vector<std::string> filenames;
+
+  //! The number of timesteps kept resident, including the current timestep.
+  size_t windowSize;
+
+  //! Resident timestep volumes by timestep index, only accessed on the calling thread.
+  std::map<size_t, OSPVolume> resident;
+
+  //! Voxel data read by the background thread for timesteps not yet resident, by timestep index.
+  std::map<size_t, std::vector<unsigned char> > loaded;
+
+  //! Timesteps waiting to be read, in order.
+  std::deque<size_t> queue;
+
+  //! The timestep currently being read, if any.
+  ssize_t importing;
+
+  //! Request the background thread to exit.
+  bool shutdown;
+
+  //! The background thread reading queued timesteps.
+  embree::thread_t thread;
+
+  //! Protects the state shared with the background thread.
+  embree::MutexSys mutex;
+
+  //! Signals changes to the state shared with the background thread.
+  embree::ConditionSys condition;
+
+  //! Read the volume specification shared by all timesteps from the time series volume.
+  void getTimestepParameters();
+
+  //! Read the voxel data of a timestep, called on the background thread.
+  void readTimestep(size_t index, std::vector<unsigned char> &voxels) const;
+
+  //! Create the volume for a timestep from its voxel data, and commit it.
+  OSPVolume createTimestep(const std::vector<unsigned char> &voxels) const;
+
+  //! Entry point of the background thread.
+  static void threadFunction(void *loader);
+
+  //! Print an error message.
+  void emitMessage(const std::string &kind, const std::string &message) const
+    { std::cerr << "  " + toString() + "  " + kind + ": " + message + "." << std::endl; }
+
+  //! Error checking.
+  void exitOnCondition(bool condition, const std::string &message) const
+    { if (!condition) return;  emitMessage("ERROR", message);  exit(1); }
+
+};
@@ -17,6 +17,7 @@
 #include <stdarg.h>
 #include <vector>
 #include <cstring>
+#include <cmath>
 #include "SeismicHorizonFile.h"
 
 OSPTriangleMesh SeismicHorizonFile::importTriangleMesh(OSPTriangleMesh triangleMesh)
@@ -24,9 +25,21 @@ OSPTriangleMesh SeismicHorizonFile::importTriangleMesh(OSPTriangleMesh triangleM
   // Get scaling parameter if provided.
   ospGetVec3f(triangleMesh, "scale", &scale);
 
+  // Whether to emit a heightfield geometry instead of the triangle mesh.
+  int heightfield = 0;
+  ospGeti(triangleMesh, "heightfield", &heightfield);
+
   // Open seismic data file and populate attributes.
   exitOnCondition(openSeismicDataFile(triangleMesh) != true, "unable to open file '" + filename + "'");
 
+  // Import the horizon data from the file as a heightfield, which takes the place of the triangle mesh.
+  if (heightfield) {
+    OSPGeometry geometry = importHorizonHeightfield();
+    exitOnCondition(geometry == NULL, "error importing horizon data.");
+    ospRelease(triangleMesh);
+    return((OSPTriangleMesh) geometry);
+  }
+
   // Import the horizon data from the file into the triangle mesh.
   exitOnCondition(importHorizonData(triangleMesh) != true, "error importing horizon data.");
 
@@ -71,7 +84,7 @@ bool SeismicHorizonFile::openSeismicDataFile(OSPTriangleMesh triangleMesh)
   return true;
 }
 
-bool SeismicHorizonFile::importHorizonData(OSPTriangleMesh triangleMesh)
+float *SeismicHorizonFile::readHorizonVolume()
 {
   // Allocate memory for all traces.
   float * volumeBuffer = (float *)malloc(dimensions.x*dimensions.y*dimensions.z * sizeof(float));
@@ -94,6 +107,46 @@ bool SeismicHorizonFile::importHorizonData(OSPTriangleMesh triangleMesh)
     }
   }
 
+  // Clean up.
+  free(traceBuffer);
+
+  // Close the seismic data file.
+  cdds_close(inputBinTag);
+
+  return volumeBuffer;
+}
+
+OSPGeometry SeismicHorizonFile::importHorizonHeightfield()
+{
+  // The volume buffer holds one height grid per horizon, with the first dimension varying fastest.
+  float * volumeBuffer = readHorizonVolume();
+
+  // Assume horizon height coordinate must be > 0 to be valid; the heightfield skips triangles touching NaN heights.
+  for(long i=0; i<long(dimensions.x)*dimensions.y*dimensions.z; i++)
+    if (!(volumeBuffer[i] > 0.f)) volumeBuffer[i] = NAN;
+
+  OSPGeometry geometry = ospNewGeometry("heightfield");
+  if (geometry == NULL) { free(volumeBuffer);  return(NULL); }
+
+  OSPData heightData = ospNewData(long(dimensions.x)*dimensions.y*dimensions.z, OSP_FLOAT, volumeBuffer);
+  ospSetData(geometry, "heights", heightData);
+  ospSetVec3i(geometry, "dimensions", dimensions);
+
+  // Heights go along x, the first and second dimension along y and z, as in the triangle mesh.
+  ospSet1i(geometry, "heightAxis", 0);
+  ospSetVec3f(geometry, "spacing", osp::vec3f(deltas.x * scale.y, deltas.y * scale.z, deltas.z * scale.x));
+
+  // Clean up.
+  free(volumeBuffer);
+
+  return geometry;
+}
+
+bool SeismicHorizonFile::importHorizonData(OSPTriangleMesh triangleMesh)
+{
+  // Read all horizons into the volume buffer.
+  float * volumeBuffer = readHorizonVolume();
+
   // Generate triangle mesh for each horizon.
   std::vector<osp::vec3fa> vertices;
   std::vector<osp::vec3fa> vertexNormals;
@@ -163,10 +216,6 @@ bool SeismicHorizonFile::importHorizonData(OSPTriangleMesh triangleMesh)
 
   // Clean up.
   free(volumeBuffer);
-  free(traceBuffer);
-
-  // Close the seismic data file.
-  cdds_close(inputBinTag);
 
   return true;
 }
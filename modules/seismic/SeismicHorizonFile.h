@@ -58,7 +58,13 @@ private:
   //! Open the seismic data file and populate attributes.
   bool openSeismicDataFile(OSPTriangleMesh triangleMesh);
 
-  //! Import the horizon data from the file.
+  //! Read all horizons from the file, one height grid per horizon.
+  float *readHorizonVolume();
+
+  //! Import the horizon data from the file into the triangle mesh.
   bool importHorizonData(OSPTriangleMesh triangleMesh);
 
+  //! Import the horizon data from the file as a heightfield geometry.
+  OSPGeometry importHorizonHeightfield();
+
 };
@@ -32,6 +32,11 @@ namespace ospray {
     //! \brief commit the material's parameters
     virtual void commit() {}
 
+    /*! \brief whether the material has an opacity map whose cut-out
+        parts geometries should skip during traversal; the ISPC
+        equivalent of such a material implements 'getOpacity' */
+    virtual bool hasOpacityMap() const { return false; }
+
     /*! \brief creates an abstract material class of given type 
 
       The respective material type must be a registered material type
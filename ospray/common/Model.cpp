@@ -23,6 +23,10 @@
 #include "embree2/rtcore_geometry.h"
 // ispc exports
 #include "Model_ispc.h"
+// embree
+#include "common/sys/taskscheduler.h"
+// stl
+#include <algorithm>
 
 
 namespace ospray {
@@ -30,11 +34,148 @@ namespace ospray {
   using std::cout;
   using std::endl;
 
+  using embree::TaskScheduler;
+
+  //! task preparing one geometry per task index, see Geometry::prepare
+  struct PrepareGeometryTask : public embree::RefCount {
+    Model                      *model;
+    std::vector<Geometry *>     geometries;
+    //! message of the exception thrown by each geometry, if any
+    std::vector<std::string>    errors;
+    embree::TaskScheduler::Task task;
+
+    TASK_RUN_FUNCTION(PrepareGeometryTask,run);
+    TASK_COMPLETE_FUNCTION(PrepareGeometryTask,finish);
+  };
+
+  void PrepareGeometryTask::run(size_t threadIndex, 
+                                size_t threadCount, 
+                                size_t taskIndex, 
+                                size_t taskCount, 
+                                TaskScheduler::Event* event) 
+  {
+    // exceptions must not escape the worker threads, they are rethrown after the sync
+    try {
+      geometries[taskIndex]->prepare(model);
+    } catch (const std::exception &e) {
+      errors[taskIndex] = e.what();
+    }
+  }
+
+  void PrepareGeometryTask::finish(size_t threadIndex, 
+                                   size_t threadCount, 
+                                   TaskScheduler::Event* event) 
+  {}
+
+  void Model::prepareGeometries(size_t begin, size_t end)
+  {
+    if (end <= begin) return;
+
+    Ref<PrepareGeometryTask> prepareTask = new PrepareGeometryTask;
+    prepareTask->model = this;
+    for (size_t i=begin; i < end; i++)
+      prepareTask->geometries.push_back(geometry[i].ptr);
+    prepareTask->errors.resize(end - begin);
+
+    TaskScheduler::EventSync sync;
+    prepareTask->task = embree::TaskScheduler::Task
+      (&sync,
+       prepareTask->_run,prepareTask.ptr,
+       end - begin,
+       prepareTask->_finish,prepareTask.ptr,
+       "Model::PrepareGeometryTask");
+    TaskScheduler::addTask(-1, TaskScheduler::GLOBAL_BACK, &prepareTask->task); 
+    sync.sync();
+
+    // report the error of the first failing geometry, as a serial loop would
+    for (size_t i=0; i < prepareTask->errors.size(); i++)
+      if (!prepareTask->errors[i].empty())
+        throw std::runtime_error(prepareTask->errors[i]);
+  }
+
   Model::Model()
+    : embreeSceneHandle(NULL), dynamicScene(false), bvhBuildMode("default"), geometryModified(true)
   {
     managedObjectType = OSP_MODEL;
     this->ispcEquivalent = ispc::Model_create(this);
   }
+
+  RTCSceneFlags Model::getSceneFlags() const
+  {
+    int flags = (dynamicScene || bvhBuildMode == "fast") ? RTC_SCENE_DYNAMIC : RTC_SCENE_STATIC;
+
+    // spatial split builds are only available for static scenes
+    if (bvhBuildMode == "high_quality" && !(flags & RTC_SCENE_DYNAMIC))
+      flags |= RTC_SCENE_HIGH_QUALITY;
+    if (bvhBuildMode == "compact")
+      flags |= RTC_SCENE_COMPACT;
+
+    return (RTCSceneFlags)flags;
+  }
+
+  RTCGeometryFlags Model::getGeometryFlags() const
+  {
+    // geometries of dynamic models are refit, fast builds use per-geometry Morton builders
+    if (dynamicScene) return RTC_GEOMETRY_DEFORMABLE;
+    if (bvhBuildMode == "fast") return RTC_GEOMETRY_DYNAMIC;
+    return RTC_GEOMETRY_STATIC;
+  }
+
+  bool Model::isInstancing() const
+  {
+    for (size_t i=0; i < geometry.size(); i++)
+      if (geometry[i]->isInstancing()) return true;
+    return false;
+  }
+
+  Model::~Model()
+  {
+    for (size_t i=0; i < finalizedGeometry.size(); i++)
+      finalizedGeometry[i]->unregisterListener(this);
+  }
+
+  void Model::dependencyGotChanged(ManagedObject *object)
+  {
+    // one of the geometries, or the data it refers to, got committed
+    geometryModified = true;
+    modifiedGeometry.insert(object);
+  }
+
+  bool Model::updateDynamicScene()
+  {
+    // the scene must exist and still hold the geometries it was built
+    // from, in the same order; geometries may only have been appended
+    if (!dynamicScene || embreeSceneHandle == NULL || finalizedGeometry.size() > geometry.size()
+        || !std::equal(finalizedGeometry.begin(), finalizedGeometry.end(), geometry.begin()))
+      return false;
+
+    // untouched geometries are not finalized again
+    for (size_t i=0; i < finalizedGeometry.size(); i++) {
+      if (modifiedGeometry.count(geometry[i].ptr) == 0) continue;
+
+      if (logLevel >= 2) 
+        std::cout << "Updating geometry " << i << std::endl << std::flush;
+
+      if (!geometry[i]->update(this))
+        return false;
+    }
+
+    // appended geometries are added to the existing scene
+    ispc::Model_setGeometryCount(getIE(), geometry.size());
+    prepareGeometries(finalizedGeometry.size(), geometry.size());
+
+    for (size_t i=finalizedGeometry.size(); i < geometry.size(); i++) {
+
+      if (logLevel >= 2) 
+        std::cout << "Finalizing added geometry " << i << std::endl << std::flush;
+
+      geometry[i]->finalize(this);
+      ispc::Model_setGeometry(getIE(), i, geometry[i]->getIE());
+    }
+
+    return true;
+  }
+
   void Model::finalize()
   {
     if (logLevel >= 2) {
@@ -43,28 +184,75 @@ namespace ospray {
            << geometry.size() << " geometries and " << volumes.size() << " volumes" << std::endl << std::flush;
     }
 
-    ispc::Model_init(getIE(), geometry.size(), volumes.size());
-    embreeSceneHandle = (RTCScene)ispc::Model_getEmbreeSceneHandle(getIE());
+    const bool wasDynamic = dynamicScene;
+    const std::string previousBuildMode = bvhBuildMode;
+    dynamicScene = getParam1i("dynamicScene", 0);
+    bvhBuildMode = getParamString("bvhBuildMode", "default");
 
-    bounds = embree::empty;
+    if (bvhBuildMode != "default" && bvhBuildMode != "fast" && bvhBuildMode != "high_quality" && bvhBuildMode != "compact") {
+      std::cout << "#osp: warning - unknown bvhBuildMode '" << bvhBuildMode << "', using 'default'" << std::endl;
+      bvhBuildMode = "default";
+    }
+
+    // a different build mode needs a new embree scene
+    const bool sameScene = dynamicScene == wasDynamic && bvhBuildMode == previousBuildMode;
+
+    if (embreeSceneHandle && sameScene && !geometryModified && finalizedGeometry == geometry) {
+      // no geometry or data changed since the last commit, keep the embree scene as is
+      if (logLevel >= 2) 
+        std::cout << "Geometries unchanged, reusing embree scene" << std::endl << std::flush;
+
+      ispc::Model_initVolumes(getIE(), volumes.size());
+    } else if (wasDynamic && sameScene && updateDynamicScene()) {
+      // the embree scene is kept, only the volumes are set anew
+      ispc::Model_initVolumes(getIE(), volumes.size());
+      rtcCommit(embreeSceneHandle);
+    } else {
+      ispc::Model_init(getIE(), geometry.size(), volumes.size(), getSceneFlags());
+      embreeSceneHandle = (RTCScene)ispc::Model_getEmbreeSceneHandle(getIE());
 
-    // for now, only implement triangular geometry...
-    for (size_t i=0; i < geometry.size(); i++) {
+      // the per-geometry work runs in parallel, registration with
+      // embree stays serial so geometry IDs follow the geometry order
+      prepareGeometries(0, geometry.size());
 
-      if (logLevel >= 2) {
-        std::cout << "=======================================================" << std::endl;
-        std::cout << "Finalizing geometry " << i << std::endl << std::flush;
+      // for now, only implement triangular geometry...
+      for (size_t i=0; i < geometry.size(); i++) {
+
+        if (logLevel >= 2) {
+          std::cout << "=======================================================" << std::endl;
+          std::cout << "Finalizing geometry " << i << std::endl << std::flush;
+        }
+
+        geometry[i]->finalize(this);
+
+        ispc::Model_setGeometry(getIE(), i, geometry[i]->getIE());
       }
 
-      geometry[i]->finalize(this);
+      rtcCommit(embreeSceneHandle);
+    }
 
+    bounds = embree::empty;
+    for (size_t i=0; i < geometry.size(); i++)
       bounds.extend(geometry[i]->bounds);
-      ispc::Model_setGeometry(getIE(), i, geometry[i]->getIE());
-    }
+
+    // listen for changes of the geometries now in the model
+    for (size_t i=0; i < finalizedGeometry.size(); i++)
+      finalizedGeometry[i]->unregisterListener(this);
+    for (size_t i=0; i < geometry.size(); i++)
+      geometry[i]->registerListener(this);
+
+    finalizedGeometry = geometry;
+    geometryModified = false;
+    modifiedGeometry.clear();
 
     for (size_t i=0 ; i < volumes.size() ; i++) ispc::Model_setVolume(getIE(), i, volumes[i]->getIE());
-    
-    rtcCommit(embreeSceneHandle);
+
+    // Build the acceleration structure over the volume bounds.
+    ispc::Model_buildVolumeScene(getIE());
+
+    // instances of this model refer to its (possibly new) embree scene,
+    // the models containing them have to be finalized again
+    notifyListenersThatObjectGotChanged();
   }
 
 } // ::ospray
@@ -22,6 +22,7 @@
 
 // stl stuff
 #include <vector>
+#include <set>
 
 // embree stuff
 #include "embree2/rtcore.h"
@@ -40,11 +41,17 @@ namespace ospray {
   struct Model : public ManagedObject
   {
     Model();
+    virtual ~Model();
 
     //! \brief common function to help printf-debugging 
     virtual std::string toString() const { return "ospray::Model"; }
     virtual void finalize();
 
+    /*! \brief marks the model dirty when one of its geometries (or
+        the data arrays, volumes or instanced models it refers to) got
+        committed */
+    virtual void dependencyGotChanged(ManagedObject *object);
+
     typedef std::vector<Ref<Geometry> > GeometryVector;
     GeometryVector geometry;
 
@@ -54,6 +61,49 @@ namespace ospray {
 
     //! \brief the embree scene handle for this geometry
     RTCScene embreeSceneHandle; 
+
+    /*! \brief whether the embree scene is kept alive across commits
+        ("dynamicScene" parameter), refitting changed geometries
+        instead of rebuilding the whole scene */
+    bool dynamicScene;
+
+    /*! \brief BVH build mode ("bvhBuildMode" parameter): "default"
+        (static SAH build), "fast" (two-level BVH over per-geometry
+        Morton builds, for interactive editing), "high_quality" (SAH
+        with spatial splits, for final renders) or "compact" (memory
+        conservative leaves, for huge scenes) */
+    std::string bvhBuildMode;
+
+    //! embree scene flags for the dynamic scene setting and BVH build mode
+    RTCSceneFlags getSceneFlags() const;
+
+    //! embree geometry flags for geometries of this model
+    RTCGeometryFlags getGeometryFlags() const;
+
+    //! whether any geometry put an embree instance into the scene, see Geometry::isInstancing
+    bool isInstancing() const;
+
+    /*! geometries registered with the embree scene at the last
+        finalize, in registration order */
+    GeometryVector finalizedGeometry;
+
+    /*! whether any geometry got modified since the last finalize; the
+        embree scene is reused as is otherwise */
+    bool geometryModified;
+
+    /*! geometries committed (or whose data got committed) since the
+        last finalize of this model; tracked per model since a
+        geometry may be part of several models */
+    std::set<ManagedObject *> modifiedGeometry;
+
+  private:
+    /*! prepare the geometries in [begin,end) in parallel, see Geometry::prepare */
+    void prepareGeometries(size_t begin, size_t end);
+
+    /*! refit the modified geometries of a dynamic scene in place and
+        add appended geometries; returns false if the scene has to be
+        rebuilt instead */
+    bool updateDynamicScene();
   };
 
 } // ::ospray
@@ -31,6 +31,12 @@ namespace ospray {
     return malloc(size);
   }
 
+  /*! release memory allocated with malloc64 */
+  extern "C" void free64(void *ptr)
+  {
+    free(ptr);
+  }
+
   /*! logging level - '0' means 'no logging at all', increasing
       numbers mean increasing verbosity of log messages */
   uint32 logLevel = 0;
@@ -165,6 +171,10 @@ namespace ospray {
     case OSP_ULONG2:     return sizeof(embree::Vec2<uint64>);
     case OSP_ULONG3:     return sizeof(embree::Vec3<uint64>);
     case OSP_ULONG4:     return sizeof(embree::Vec4<uint64>);
+    case OSP_USHORT:     return sizeof(uint16);
+    case OSP_USHORT2:    return sizeof(embree::Vec2<uint16>);
+    case OSP_USHORT3:    return sizeof(embree::Vec3<uint16>);
+    case OSP_USHORT4:    return sizeof(embree::Vec4<uint16>);
     case OSP_FLOAT:     return sizeof(float);
     case OSP_FLOAT2:    return sizeof(embree::Vec2<float>);
     case OSP_FLOAT3:    return sizeof(embree::Vec3<float>);
@@ -199,6 +209,10 @@ namespace ospray {
     if (strcmp(string, "uint2" ) == 0) return(OSP_UINT2);
     if (strcmp(string, "uint3" ) == 0) return(OSP_UINT3);
     if (strcmp(string, "uint4" ) == 0) return(OSP_UINT4);
+    if (strcmp(string, "ushort" ) == 0) return(OSP_USHORT);
+    if (strcmp(string, "ushort2") == 0) return(OSP_USHORT2);
+    if (strcmp(string, "ushort3") == 0) return(OSP_USHORT3);
+    if (strcmp(string, "ushort4") == 0) return(OSP_USHORT4);
     return(OSP_UNKNOWN);
 
   }
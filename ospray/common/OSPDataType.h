@@ -60,6 +60,9 @@ typedef enum {
   //! Unsigned 64-bit integer scalar and vector types.
   OSP_ULONG, OSP_ULONG2, OSP_ULONG3, OSP_ULONG4,
 
+  //! Unsigned 16-bit integer scalar and vector types.
+  OSP_USHORT, OSP_USHORT2, OSP_USHORT3, OSP_USHORT4,
+
   //! Single precision floating point scalar and vector types.
   OSP_FLOAT=100, OSP_FLOAT2, OSP_FLOAT3, OSP_FLOAT4, OSP_FLOAT3A,
 
@@ -62,11 +62,40 @@ namespace ospray {
       _materialList = (void*)ispcMaterials;
     }
 
-    ispc::CylindersGeometry_set(getIE(),model->getIE(),
-                                data->data,_materialList,
-                                numCylinders,bytesPerCylinder,
-                                radius,materialID,
-                                offset_v0,offset_v1,offset_radius,offset_materialID);
+    if (!getParam1i("hair",0)) {
+      ispc::CylindersGeometry_set(getIE(),model->getIE(),
+                                  data->data,_materialList,
+                                  numCylinders,bytesPerCylinder,
+                                  radius,materialID,
+                                  offset_v0,offset_v1,offset_radius,offset_materialID);
+      return;
+    }
+
+    // each cylinder becomes a straight cubic bezier curve of constant radius
+    const uint32 geomID = rtcNewHairGeometry(model->embreeSceneHandle,model->getGeometryFlags(),
+                                             numCylinders,4*numCylinders);
+
+    vec4f  *curveVertex = (vec4f *)rtcMapBuffer(model->embreeSceneHandle,geomID,RTC_VERTEX_BUFFER);
+    uint32 *curveIndex  = (uint32*)rtcMapBuffer(model->embreeSceneHandle,geomID,RTC_INDEX_BUFFER);
+    for (size_t i=0;i<numCylinders;i++) {
+      const uint8 *cylinderPtr = (const uint8*)data->data + bytesPerCylinder*i;
+      const vec3f A = *(const vec3f*)(cylinderPtr+offset_v0);
+      const vec3f B = *(const vec3f*)(cylinderPtr+offset_v1);
+      const float r = offset_radius >= 0 ? *(const float*)(cylinderPtr+offset_radius) : radius;
+      for (int j=0;j<4;j++) {
+        const vec3f P = A + (j/3.f) * (B-A);
+        curveVertex[4*i+j] = vec4f(P.x,P.y,P.z,r);
+      }
+      curveIndex[i] = 4*i;
+    }
+    rtcUnmapBuffer(model->embreeSceneHandle,geomID,RTC_VERTEX_BUFFER);
+    rtcUnmapBuffer(model->embreeSceneHandle,geomID,RTC_INDEX_BUFFER);
+
+    ispc::CylindersGeometry_setHair(getIE(),model->getIE(),geomID,
+                                    data->data,_materialList,
+                                    numCylinders,bytesPerCylinder,
+                                    radius,materialID,
+                                    offset_v0,offset_v1,offset_radius,offset_materialID);
   }
 
 
@@ -43,6 +43,7 @@ namespace ospray {
     <dt><code>int32        offset_radius = 6*sizeof(float)</code></dt><dd>Offset (in bytes) of each cylinder's 'float radius' value within each cylinder. Setting this value to -1 means that there is no per-cylinder radius value, and that all cylinders should use the (shared) 'radius' value instead</dd>
     <dt><code>int32        offset_materialID = -1</code></dt><dd>Offset (in bytes) of each cylinder's 'int materialID' value within each cylinder. Setting this value to -1 means that there is no per-cylinder material ID, and that all cylinders share the same per-geometry 'materialID'</dd>
     <dt><code>Data<float>  cylinders</code></dt><dd>Array of data elements.</dd>
+    <dt><code>int32        hair = 0</code></dt><dd>If nonzero, each cylinder is registered as an embree hair curve and intersected by embree's oriented bounding box hair BVH instead of a user geometry callback; see the "hair" parameter of \ref geometry_streamlines</dd>
     </dl>
 
     The functionality for this geometry is implemented via the
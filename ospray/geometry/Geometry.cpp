@@ -17,6 +17,7 @@
 // ospray 
 #include "Geometry.h"
 #include "ospray/common/Library.h"
+#include "ospray/common/Data.h"
 // stl 
 #include <map>
 // ISPC exports
@@ -28,6 +29,45 @@ namespace ospray {
 
   std::map<std::string, creatorFct> geometryRegistry;
 
+  Geometry::~Geometry()
+  {
+    for (size_t i = 0; i < dependencies.size(); i++)
+      dependencies[i]->unregisterListener(this);
+    if (material) material->unregisterListener(this);
+  }
+
+  void Geometry::commit()
+  {
+    // listen for changes of the objects the parameters refer to
+    for (size_t i = 0; i < dependencies.size(); i++)
+      dependencies[i]->unregisterListener(this);
+    dependencies.clear();
+
+    for (size_t i = 0; i < paramList.size(); i++)
+      if (paramList[i]->type == OSP_OBJECT && paramList[i]->ptr) {
+        paramList[i]->ptr->registerListener(this);
+        dependencies.push_back(paramList[i]->ptr);
+
+        // also the objects in object arrays, e.g. the models of an instance array
+        Data *data = dynamic_cast<Data *>(paramList[i]->ptr);
+        if (data && data->type == OSP_OBJECT)
+          for (size_t j = 0; j < data->numItems; j++) {
+            ManagedObject *object = ((ManagedObject **)data->data)[j];
+            if (!object) continue;
+            object->registerListener(this);
+            dependencies.push_back(object);
+          }
+      }
+
+    // let the models containing this geometry know
+    notifyListenersThatObjectGotChanged();
+  }
+
+  void Geometry::dependencyGotChanged(ManagedObject *object)
+  {
+    notifyListenersThatObjectGotChanged();
+  }
+
   //! set given geometry's material. 
   /*! all material assignations should go through this function; the
     'material' field itself is private). This allows the
@@ -36,12 +76,19 @@ namespace ospray {
     c++-side's material gets changed */
   void Geometry::setMaterial(Material *mat)
   {
+    // listen for commits of the material, e.g. adding an opacity map
+    if (material) material->unregisterListener(this);
     material = mat;
+    if (material) material->registerListener(this);
+
     if (!getIE()) 
       std::cout << "#osp: warning - geometry does not have an ispc equivalent!" << std::endl;
     else {
       ispc::Geometry_setMaterial(this->getIE(),mat?mat->getIE():NULL);
     }
+
+    // let the models containing this geometry know
+    notifyListenersThatObjectGotChanged();
   }
 
 
@@ -39,6 +39,20 @@ namespace ospray {
     //! constructor
     Geometry() : bounds(embree::empty) { managedObjectType = OSP_GEOMETRY; }
 
+    //! destructor, no longer listens for changes of the objects this geometry depends on
+    virtual ~Geometry();
+
+    /*! \brief commit the geometry, marking it for an update on the
+        next commit of the models containing it and listening for
+        changes of the data arrays and other objects its parameters
+        refer to */
+    virtual void commit();
+
+    /*! \brief passes the commit of one of the objects this geometry
+        depends on to the models containing it, which mark the
+        geometry modified */
+    virtual void dependencyGotChanged(ManagedObject *object);
+
     //! set given geometry's material. 
     /*! all material assignations should go through this function; the
         'material' field itself is private). This allows the
@@ -53,10 +67,28 @@ namespace ospray {
     //! \brief common function to help printf-debugging 
     virtual std::string toString() const { return "ospray::Geometry"; }
 
+    /*! \brief prepares this geometry for finalize, e.g. by reading and
+        validating its parameters and computing its bounds. Called for
+        all geometries of a model in parallel before they get finalized
+        one after another; must not touch the model's embree scene */
+    virtual void prepare(Model *model) {}
+
     /*! \brief integrates this geometry's primitives into the respective
         model's acceleration structure */
     virtual void finalize(Model *model) {}
 
+    /*! \brief updates this geometry's primitives in place after it
+        got modified, for a model that keeps its embree scene
+        ("dynamicScene"). Returns false if the geometry has to be
+        finalized anew, which makes the model rebuild its scene. */
+    virtual bool update(Model *model) { return false; }
+
+    /*! \brief whether the last finalize put an embree instance into
+        the model's scene. embree only supports a single level of
+        instancing, so a model containing such a geometry cannot be
+        instanced itself */
+    virtual bool isInstancing() const { return false; }
+
     /*! \brief creates an abstract geometry class of given type 
 
       The respective geometry type must be a registered geometry type
@@ -67,6 +99,9 @@ namespace ospray {
 
     box3f bounds;
 
+    //! objects referred to by parameters at the last commit, this geometry listens for their changes
+    std::vector<Ref<ManagedObject> > dependencies;
+
   private:
     //! material associated to this geometry
     /*! this field is private to make sure it is only set through
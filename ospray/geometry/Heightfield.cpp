@@ -0,0 +1,148 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+// ospray
+#include "Heightfield.h"
+#include "ospray/common/Model.h"
+// ispc-generated files
+#include "Heightfield_ispc.h"
+// std
+#include <cmath>
+
+namespace ospray {
+
+  Heightfield::Heightfield()
+  {
+    this->ispcEquivalent = ispc::Heightfield_create(this);
+  }
+
+  void Heightfield::prepare(Model *model)
+  {
+    heightData = getParamData("heights",NULL);
+    dimensions = getParam3i("dimensions",vec3i(0));
+    origin     = getParam3f("origin",vec3f(0.f));
+    spacing    = getParam3f("spacing",vec3f(1.f));
+    heightAxis = getParam1i("heightAxis",2);
+
+    if (dimensions.z < 1) dimensions.z = 1;
+
+    if (heightData.ptr == NULL)
+      throw std::runtime_error("#ospray:geometry/heightfield: no 'heights' data specified");
+    if (dimensions.x < 2 || dimensions.y < 2)
+      throw std::runtime_error("#ospray:geometry/heightfield: 'dimensions' need to be at least 2x2");
+    if (heightAxis < 0 || heightAxis > 2)
+      throw std::runtime_error("#ospray:geometry/heightfield: 'heightAxis' needs to be 0, 1 or 2");
+    if (spacing.x == 0.f || spacing.y == 0.f || spacing.z == 0.f)
+      throw std::runtime_error("#ospray:geometry/heightfield: invalid 'spacing'");
+
+    const int64 samplesPerLayer = int64(dimensions.x) * dimensions.y;
+    if (heightData->numBytes < samplesPerLayer * dimensions.z * sizeof(float))
+      throw std::runtime_error("#ospray:geometry/heightfield: 'heights' has fewer samples than 'dimensions' specify");
+
+    // number of nodes on each level, halving down to a single node
+    levelNodesX.clear();
+    levelNodesY.clear();
+    int32 nodesX = dimensions.x - 1;
+    int32 nodesY = dimensions.y - 1;
+    while (true) {
+      levelNodesX.push_back(nodesX);
+      levelNodesY.push_back(nodesY);
+      if (nodesX == 1 && nodesY == 1) break;
+      nodesX = (nodesX + 1) / 2;
+      nodesY = (nodesY + 1) / 2;
+    }
+    const size_t numLevels = levelNodesX.size();
+
+    levelOffset.resize(dimensions.z * numLevels);
+    int64 numNodes = 0;
+    for (int32 layer = 0; layer < dimensions.z; layer++)
+      for (size_t level = 0; level < numLevels; level++) {
+        levelOffset[layer * numLevels + level] = numNodes;
+        numNodes += int64(levelNodesX[level]) * levelNodesY[level];
+      }
+    range.resize(numNodes);
+
+    const float *height = (const float *)heightData->data;
+    const vec2f emptyRange(embree::pos_inf,embree::neg_inf);
+    bounds = embree::empty;
+
+    for (int32 layer = 0; layer < dimensions.z; layer++) {
+      const float *layerHeight = height + layer * samplesPerLayer;
+      vec2f *cellRange = &range[levelOffset[layer * numLevels]];
+
+      // level 0: range of the (valid) heights at the corners of each cell
+      for (int32 j = 0; j < dimensions.y - 1; j++)
+        for (int32 i = 0; i < dimensions.x - 1; i++) {
+          vec2f r = emptyRange;
+          for (int32 c = 0; c < 4; c++) {
+            const float h = layerHeight[int64(j + (c >> 1)) * dimensions.x + i + (c & 1)];
+            if (std::isnan(h)) continue;
+            r.x = std::min(r.x, h);
+            r.y = std::max(r.y, h);
+          }
+          cellRange[int64(j) * levelNodesX[0] + i] = r;
+        }
+
+      // further levels: union of the (up to four) child nodes
+      for (size_t level = 1; level < numLevels; level++) {
+        const vec2f *childRange = &range[levelOffset[layer * numLevels + level - 1]];
+        vec2f *nodeRange = &range[levelOffset[layer * numLevels + level]];
+        for (int32 y = 0; y < levelNodesY[level]; y++)
+          for (int32 x = 0; x < levelNodesX[level]; x++) {
+            vec2f r = emptyRange;
+            for (int32 c = 0; c < 4; c++) {
+              const int32 childX = 2*x + (c & 1);
+              const int32 childY = 2*y + (c >> 1);
+              if (childX >= levelNodesX[level-1] || childY >= levelNodesY[level-1]) continue;
+              const vec2f &child = childRange[int64(childY) * levelNodesX[level-1] + childX];
+              r.x = std::min(r.x, child.x);
+              r.y = std::max(r.y, child.y);
+            }
+            nodeRange[int64(y) * levelNodesX[level] + x] = r;
+          }
+      }
+
+      const vec2f &layerRange = range[levelOffset[layer * numLevels + numLevels - 1]];
+      if (layerRange.x > layerRange.y) continue;
+      bounds.extend(toWorld(vec3f(0.f, 0.f, layerRange.x)));
+      bounds.extend(toWorld(vec3f(dimensions.x - 1, dimensions.y - 1, layerRange.y)));
+    }
+  }
+
+  vec3f Heightfield::toWorld(const vec3f &sample) const
+  {
+    const vec3f local = sample * spacing;
+    vec3f world;
+    world[(heightAxis + 1) % 3] = local.x;
+    world[(heightAxis + 2) % 3] = local.y;
+    world[heightAxis] = local.z;
+    return origin + world;
+  }
+
+  void Heightfield::finalize(Model *model)
+  {
+    ispc::Heightfield_set(getIE(),model->getIE(),
+                          heightData->data,
+                          dimensions.x,dimensions.y,dimensions.z,
+                          heightAxis,
+                          (ispc::vec3f&)origin,(ispc::vec3f&)spacing,
+                          &range[0],&levelOffset[0],
+                          &levelNodesX[0],&levelNodesY[0],
+                          levelNodesX.size());
+  }
+
+  OSP_REGISTER_GEOMETRY(Heightfield,heightfield);
+
+} // ::ospray
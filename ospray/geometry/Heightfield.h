@@ -0,0 +1,81 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+#pragma once
+
+#include "Geometry.h"
+#include "ospray/common/Data.h"
+
+namespace ospray {
+
+  /*! \defgroup geometry_heightfield Heightfields ("heightfield")
+
+    \ingroup ospray_supported_geometries
+
+    \brief Geometry representing one or more regular height grids
+
+    Implements a surface over a regular 2D grid of height samples,
+    triangulated with two triangles per cell, that is intersected
+    directly instead of being turned into a triangle mesh. Rays
+    traverse a min/max hierarchy over the heights of each grid, so
+    apart from the height samples themselves this only needs about a
+    third of a float2 per cell, and there is no BVH to build.
+
+    Parameters:
+    <dl>
+    <dt><code>Data<float> heights</code></dt><dd>Height samples, i fastest, one grid after another. Samples that are NaN mark holes; triangles touching them are not part of the surface</dd>
+    <dt><code>vec3i dimensions</code></dt><dd>Number of samples along i and j, and number of grids (layers, at least one)</dd>
+    <dt><code>int32 heightAxis = 2</code></dt><dd>World axis (0, 1 or 2 for x, y or z) that the heights go along; the grid's i and j go along the following two axes, in cyclic order</dd>
+    <dt><code>vec3f origin = (0,0,0)</code></dt><dd>World position of sample (0,0) at height 0</dd>
+    <dt><code>vec3f spacing = (1,1,1)</code></dt><dd>Sample spacing along i and j, and scale of the heights; sample (i,j) with height h is at origin + (i,j,h)*spacing, with (i,j,h) permuted onto the world axes according to 'heightAxis'</dd>
+    </dl>
+
+    The functionality for this geometry is implemented via the
+    \ref ospray::Heightfield class.
+  */
+
+  /*! \brief A geometry for a set of height grids
+
+    Implements the \ref geometry_heightfield geometry
+  */
+  struct Heightfield : public Geometry {
+    Heightfield();
+    //! \brief common function to help printf-debugging 
+    virtual std::string toString() const { return "ospray::Heightfield"; }
+    /*! \brief parses the parameters and builds the min/max hierarchy */
+    virtual void prepare(Model *model);
+    /*! \brief integrates this geometry's primitives into the respective
+      model's acceleration structure */
+    virtual void finalize(Model *model);
+
+    Ref<Data> heightData;
+    vec3i     dimensions; //!< samples along x and y, number of layers
+    int32     heightAxis; //!< world axis the heights go along
+    vec3f     origin;
+    vec3f     spacing;
+
+    //! world space position of a (i,j,height) sample position
+    vec3f toWorld(const vec3f &sample) const;
+
+    /*! min/max height per node of each level of the hierarchy, for
+        each layer; level 0 has one node per cell, the last level a
+        single node over the whole grid */
+    std::vector<vec2f> range;
+    std::vector<int64> levelOffset; //!< offset of level L of layer l at [l*numLevels+L]
+    std::vector<int32> levelNodesX; //!< nodes along x on each level
+    std::vector<int32> levelNodesY; //!< nodes along y on each level
+  };
+
+} // ::ospray
@@ -38,6 +38,9 @@ namespace ospray {
 
     instancedScene = (Model *)getParamObject("model",NULL);
     assert(instancedScene);
+    if (instancedScene->isInstancing())
+      throw std::runtime_error("#ospray:geometry/instance: cannot instance a model that"
+                               " itself contains instances (or split sphere geometries)");
     embreeGeomID = rtcNewInstance(model->embreeSceneHandle,
                                   instancedScene->embreeSceneHandle);
 
@@ -55,6 +55,7 @@ namespace ospray {
     /*! \brief integrates this geometry's primitives into the respective
         model's acceleration structure */
     virtual void finalize(Model *model);
+    virtual bool isInstancing() const { return true; }
 
     /*! transformation matrix associated with that instance's geometry. may be embree::one */
     AffineSpace3f xfm;
@@ -0,0 +1,97 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+// ospray
+#include "InstanceArray.h"
+#include "ospray/common/Model.h"
+// ispc exports
+#include "InstanceArray_ispc.h"
+
+namespace ospray {
+
+  InstanceArray::InstanceArray()
+  {
+    this->ispcEquivalent = ispc::InstanceArray_create(this);
+  }
+
+  void InstanceArray::prepare(Model *model)
+  {
+    prototypeData   = getParamData("prototypes");
+    transformData   = getParamData("transforms");
+    prototypeIDData = getParamData("prototypeIDs");
+
+    if (!prototypeData || prototypeData->numItems == 0)
+      throw std::runtime_error("#ospray:geometry/instance_array: no 'prototypes' specified");
+    if (!transformData)
+      throw std::runtime_error("#ospray:geometry/instance_array: no 'transforms' specified");
+
+    numInstances = transformData->numBytes / sizeof(affine3f);
+    if (numInstances >= (1ULL << 31))
+      throw std::runtime_error("#ospray:geometry/instance_array: too many instances");
+    if (prototypeIDData && prototypeIDData->numBytes < numInstances*sizeof(int32))
+      throw std::runtime_error("#ospray:geometry/instance_array: 'prototypeIDs' has"
+                               " fewer entries than there are instances");
+
+    const size_t numPrototypes = prototypeData->numItems;
+    Model **prototype = (Model **)prototypeData->data;
+    ispcPrototypes.resize(numPrototypes);
+    prototypeBounds.resize(numPrototypes);
+    for (size_t i=0; i < numPrototypes; i++) {
+      if (!prototype[i] || !prototype[i]->embreeSceneHandle)
+        throw std::runtime_error("#ospray:geometry/instance_array: prototypes have"
+                                 " to be committed models");
+      if (prototype[i]->isInstancing())
+        throw std::runtime_error("#ospray:geometry/instance_array: prototypes cannot"
+                                 " contain instances (or split sphere geometries)");
+      ispcPrototypes[i]  = prototype[i]->getIE();
+      prototypeBounds[i] = prototype[i]->bounds;
+    }
+
+    const affine3f *xfm = (const affine3f *)transformData->data;
+    const int32 *prototypeID = prototypeIDData ? (const int32 *)prototypeIDData->data : NULL;
+    rcp_xfm.resize(numInstances);
+    bounds = embree::empty;
+    for (size_t i=0; i < numInstances; i++) {
+      const int32 protoID = prototypeID ? prototypeID[i] : 0;
+      if (protoID < 0 || size_t(protoID) >= numPrototypes)
+        throw std::runtime_error("#ospray:geometry/instance_array: invalid prototype ID");
+      rcp_xfm[i] = rcp(xfm[i]);
+
+      const box3f &b = prototypeBounds[protoID];
+      if (b.empty()) continue;
+      bounds.extend(xfmPoint(xfm[i],vec3f(b.lower.x,b.lower.y,b.lower.z)));
+      bounds.extend(xfmPoint(xfm[i],vec3f(b.upper.x,b.lower.y,b.lower.z)));
+      bounds.extend(xfmPoint(xfm[i],vec3f(b.lower.x,b.upper.y,b.lower.z)));
+      bounds.extend(xfmPoint(xfm[i],vec3f(b.upper.x,b.upper.y,b.lower.z)));
+      bounds.extend(xfmPoint(xfm[i],vec3f(b.lower.x,b.lower.y,b.upper.z)));
+      bounds.extend(xfmPoint(xfm[i],vec3f(b.upper.x,b.lower.y,b.upper.z)));
+      bounds.extend(xfmPoint(xfm[i],vec3f(b.lower.x,b.upper.y,b.upper.z)));
+      bounds.extend(xfmPoint(xfm[i],vec3f(b.upper.x,b.upper.y,b.upper.z)));
+    }
+  }
+
+  void InstanceArray::finalize(Model *model)
+  {
+    ispc::InstanceArray_set(getIE(),model->getIE(),
+                            &ispcPrototypes[0],&prototypeBounds[0],
+                            transformData->data,
+                            numInstances ? &rcp_xfm[0] : NULL,
+                            prototypeIDData ? prototypeIDData->data : NULL,
+                            numInstances);
+  }
+
+  OSP_REGISTER_GEOMETRY(InstanceArray,instance_array);
+
+} // ::ospray
@@ -0,0 +1,79 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+#pragma once
+
+#include "Geometry.h"
+#include "ospray/common/Data.h"
+
+namespace ospray {
+
+  /*! \defgroup geometry_instance_array Instance arrays ("instance_array")
+
+    \brief Implements instancing of many instances of a few models in
+    a single geometry.
+
+    \ingroup ospray_supported_geometries
+
+    Unlike a \ref geometry_instance, which is one object per instance,
+    an instance array holds any number of instances of a (small) set
+    of prototype models, and embree builds a single acceleration
+    structure over all of them. This keeps the per-instance cost to
+    the transformation (and its inverse) plus a prototype index, which
+    makes scenes with millions of instances (forests, particle
+    glyphs) practical.
+
+    Parameters:
+    <dl>
+    <dt><code>Data<OSPModel> prototypes</code></dt><dd>The models that get instanced; they need to be committed before the instance array</dd>
+    <dt><code>Data<float3>   transforms</code></dt><dd>Affine transformation of each instance, as four float3 per instance (the three columns of the linear part, followed by the translation)</dd>
+    <dt><code>Data<int32>    prototypeIDs</code></dt><dd>Optional index into 'prototypes' for each instance; if not specified, all instances use the first prototype</dd>
+    </dl>
+
+    The prototype models may contain regular geometries only, not
+    instances or instance arrays themselves.
+
+    The functionality for this geometry is implemented via the
+    \ref ospray::InstanceArray class.
+  */
+
+  /*! \brief An array of instances of a set of prototype models
+
+    Implements the \ref geometry_instance_array geometry
+  */
+  struct InstanceArray : public Geometry
+  {
+    /*! Constructor */
+    InstanceArray();
+    //! \brief common function to help printf-debugging 
+    virtual std::string toString() const { return "ospray::InstanceArray"; }
+    /*! \brief parses the parameters and computes the inverse
+        transformations and bounds of all instances */
+    virtual void prepare(Model *model);
+    /*! \brief integrates this geometry's primitives into the respective
+        model's acceleration structure */
+    virtual void finalize(Model *model);
+
+    Ref<Data> prototypeData;   //!< the instanced models
+    Ref<Data> transformData;   //!< per-instance transformations
+    Ref<Data> prototypeIDData; //!< per-instance prototype index (optional)
+
+    size_t numInstances;
+    std::vector<void *> ispcPrototypes;  //!< ISPC equivalents of the prototypes
+    std::vector<box3f>  prototypeBounds; //!< bounds of each prototype
+    std::vector<affine3f> rcp_xfm;       //!< inverse of each instance's transformation
+  };
+
+} // ::ospray
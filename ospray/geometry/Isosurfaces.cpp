@@ -45,6 +45,22 @@ namespace ospray {
     ispc::Isosurfaces_set(getIE(), model->getIE(), numIsovalues, isovalues, volume->getIE());
   }
 
+  bool Isosurfaces::update(Model *model) 
+  {
+    isovaluesData = getParamData("isovalues", NULL);
+    volume        = (Volume *)getParamObject("volume", NULL);
+
+    Assert(isovaluesData);
+    Assert(isovaluesData->numItems > 0);
+    Assert(volume);
+
+    numIsovalues = isovaluesData->numItems;
+    isovalues    = (float*)isovaluesData->data;
+
+    ispc::Isosurfaces_update(getIE(), numIsovalues, isovalues, volume->getIE());
+    return true;
+  }
+
   OSP_REGISTER_GEOMETRY(Isosurfaces, isosurfaces);
 
 } // ::ospray
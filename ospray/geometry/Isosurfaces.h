@@ -55,6 +55,10 @@ namespace ospray {
       model's acceleration structure */
     virtual void finalize(Model *model);
 
+    /*! \brief updates the isovalues and volume in place for a model that keeps its
+      embree scene, without registering a new embree geometry */
+    virtual bool update(Model *model);
+
     Ref<Data> isovaluesData; //!< refcounted data array for isovalues data
     Ref<Volume> volume;
 
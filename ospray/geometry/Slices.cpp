@@ -42,6 +42,28 @@ namespace ospray {
     planes    = (const vec4f*)planesData->data;
 
     ispc::Slices_set(getIE(), model->getIE(), numPlanes, (ispc::vec4f*)planes, volume->getIE());
+
+    // optionally resample the volume on each plane once, instead of for every ray hit
+    ispc::Slices_setTextureResolution(getIE(), getParam1i("textureResolution", 0));
+  }
+
+  bool Slices::update(Model *model) 
+  {
+    // a different number of planes changes the number of embree primitives
+    Data *newPlanesData = getParamData("planes", NULL);
+    if (!newPlanesData || newPlanesData->numItems != numPlanes)
+      return false;
+
+    planesData = newPlanesData;
+    volume     = (Volume *)getParamObject("volume", NULL);
+
+    Assert(volume);
+
+    planes = (const vec4f*)planesData->data;
+
+    ispc::Slices_update(getIE(), (ispc::vec4f*)planes, volume->getIE());
+    ispc::Slices_setTextureResolution(getIE(), getParam1i("textureResolution", 0));
+    return true;
   }
 
   OSP_REGISTER_GEOMETRY(Slices, slices);
@@ -35,6 +35,7 @@ namespace ospray {
     <dl>
     <dt><li><code>Data<vec4f> planes</code></dt><dd> Array of planes for all slices in this geometry. The vec4f for each plane consists of the (a,b,c,d) coefficients of the plane equation a*x + b*y + c*z + d = 0.</dd>
     <dt><li><code>Volume  volume </code></dt><dd> volume specifies the volume to be slices. The color of the slice will be mapped through the volume's transfer function.</dd>
+    <dt><li><code>int textureResolution = 0</code></dt><dd> if larger than 1, each slice is resampled from the volume into a 2D texture of this resolution when the model is committed, and ray hits look up the texture instead of sampling the volume.</dd>
     </dl>
 
     The functionality for this geometry is implemented via the
@@ -55,6 +56,10 @@ namespace ospray {
       model's acceleration structure */
     virtual void finalize(Model *model);
 
+    /*! \brief updates the planes and volume in place for a model that keeps its
+      embree scene, without registering a new embree geometry */
+    virtual bool update(Model *model);
+
     Ref<Data> planesData; //!< refcounted data array for planes data
     Ref<Volume> volume;
 
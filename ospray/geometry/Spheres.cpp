@@ -29,6 +29,14 @@ namespace ospray {
   {
     this->ispcEquivalent = ispc::Spheres_create(this);
     _materialList = NULL;
+    split = false;
+  }
+
+  Spheres::~Spheres()
+  {
+    ispc::SpheresGeometry_destroy(getIE());
+    if (_materialList)
+      free(_materialList);
   }
 
   void Spheres::finalize(Model *model) 
@@ -41,14 +49,30 @@ namespace ospray {
     offset_materialID = getParam1i("offset_materialID",-1);
     data              = getParamData("spheres",NULL);
     materialList      = getParamData("materialList",NULL);
+    quantizedRadius   = getParamData("quantized_radius",NULL);
+    radiusRange       = getParam2f("radius_range",vec2f(0.f,radius));
     
     if (data.ptr == NULL) 
       throw std::runtime_error("#ospray:geometry/spheres: no 'spheres' data specified");
     numSpheres = data->numBytes / bytesPerSphere;
     std::cout << "#osp: creating 'spheres' geometry, #spheres = " << numSpheres << std::endl;
     
-    if (numSpheres >= (1ULL << 30)) {
-      throw std::runtime_error("#ospray::Spheres: too many spheres in this sphere geometry. Consider splitting this geometry in multiple geometries with fewer spheres (you can still put all those geometries into a single model, but you can't put that many spheres into a single geometry without causing address overflows)");
+    // the packed layout (tightly packed vec3f centers with a shared
+    // or quantized radius) has its own, specialized intersector
+    const bool packed
+      = bytesPerSphere == 3*sizeof(float) && offset_center == 0
+      && offset_radius < 0 && offset_materialID < 0;
+    float radiusScale = 0.f;
+    if (quantizedRadius) {
+      if (!packed)
+        throw std::runtime_error("#ospray:geometry/spheres: 'quantized_radius' "
+                                 "requires the packed layout (bytes_per_sphere = 12, "
+                                 "no per-sphere radius or material ID)");
+      if (quantizedRadius->numBytes < numSpheres)
+        throw std::runtime_error("#ospray:geometry/spheres: 'quantized_radius' "
+                                 "has fewer entries than there are spheres");
+      radius      = radiusRange.x;
+      radiusScale = (radiusRange.y - radiusRange.x) / 255.f;
     }
 
     if (_materialList) {
@@ -64,11 +88,14 @@ namespace ospray {
       }
       _materialList = (void*)ispcMaterials;
     }
-    ispc::SpheresGeometry_set(getIE(),model->getIE(),
+    split = ispc::SpheresGeometry_set(getIE(),model->getIE(),
                               data->data,_materialList,
                               numSpheres,bytesPerSphere,
                               radius,materialID,
-                              offset_center,offset_radius,offset_materialID);
+                              offset_center,offset_radius,offset_materialID,
+                              packed,
+                              quantizedRadius ? quantizedRadius->data : NULL,
+                              radiusScale);
   }
 
   OSP_REGISTER_GEOMETRY(Spheres,spheres);
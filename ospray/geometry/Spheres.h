@@ -42,8 +42,23 @@ namespace ospray {
     <dt><code>int32        offset_radius = -1</code></dt><dd>Offset (in bytes) of each sphere's 'float radius' value within each sphere. Setting this value to -1 means that there is no per-sphere radius value, and that all spheres should use the (shared) 'radius' value instead</dd>
     <dt><code>int32        offset_materialID = -1</code></dt><dd>Offset (in bytes) of each sphere's 'int materialID' value within each sphere. Setting this value to -1 means that there is no per-sphere material ID, and that all spheres share the same per-geometry 'materialID'</dd>
     <dt><code>Data<float>  spheres</code></dt><dd> Array of data elements.</dd>
+    <dt><code>Data<uchar>  quantized_radius</code></dt><dd>Optional per-sphere radius, quantized to 8 bits; only valid with the packed layout</dd>
+    <dt><code>vec2f        radius_range = (0,radius)</code></dt><dd>Radius range that 'quantized_radius' maps [0..255] to</dd>
     </dl>
 
+    Setting 'bytes_per_sphere' to 12 without per-sphere radius or
+    material ID selects the packed layout, in which 'spheres' is a
+    tight array of vec3f centers (optionally with a separate array of
+    quantized radii), using 12 (or 13) instead of 16 bytes per sphere
+    and a specialized intersector.
+
+    Geometries with more spheres than fit into a single embree
+    geometry are split internally into chunks that are put into the
+    model as one instance; because embree only supports a single
+    level of instancing, models containing such geometries cannot
+    themselves be instanced. Each model the geometry is finalized in
+    gets its own set of chunks.
+
     The functionality for this geometry is implemented via the
     \ref ospray::Spheres class.
 
@@ -60,6 +75,8 @@ namespace ospray {
     /*! \brief integrates this geometry's primitives into the respective
       model's acceleration structure */
     virtual void finalize(Model *model);
+    //! geometries split into chunks are put into the model as an instance
+    virtual bool isInstancing() const { return split; }
 
     float radius;   //!< default radius, if no per-sphere radius was specified.
     int32 materialID;
@@ -70,11 +87,16 @@ namespace ospray {
     int64 offset_radius;
     int64 offset_materialID;
 
+    vec2f radiusRange; //!< range that the quantized radii map to
+
     Ref<Data> data;
     Ref<Data> materialList;
+    Ref<Data> quantizedRadius; //!< optional 8-bit per-sphere radii of the packed layout
     void     *_materialList;
+    bool      split; //!< split into chunks at the last finalize
 
     Spheres();
+    ~Spheres();
   };
   /*! @} */
 
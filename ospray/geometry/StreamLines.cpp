@@ -20,6 +20,9 @@
 #include "StreamLines.h"
 #include "ospray/common/Data.h"
 #include "ospray/common/Model.h"
+// embree
+#include "embree2/rtcore.h"
+#include "embree2/rtcore_geometry.h"
 // ispc-generated files
 #include "StreamLines_ispc.h"
 
@@ -47,15 +50,52 @@ namespace ospray {
     numVertices = vertexData->numItems;
     color       = colorData ? (const vec4f*)colorData->data : NULL;
 
+    useHair     = getParam1i("hair",0);
+
     std::cout << "#osp: creating streamlines geometry, "
               << "#verts=" << numVertices << ", "
               << "#segments=" << numSegments << ", "
-              << "radius=" << radius << std::endl;
+              << "radius=" << radius
+              << (useHair ? ", as hair curves" : "") << std::endl;
     
-    ispc::StreamLineGeometry_set(getIE(),model->getIE(),radius,
-                                 (ispc::vec3fa*)vertex,numVertices,
-                                 (uint32_t*)index,numSegments,
-                                 (ispc::vec4f*)color);
+    if (!useHair) {
+      ispc::StreamLineGeometry_set(getIE(),model->getIE(),radius,
+                                   (ispc::vec3fa*)vertex,numVertices,
+                                   (uint32_t*)index,numSegments,
+                                   (ispc::vec4f*)color);
+      return;
+    }
+
+    // each link becomes a straight cubic bezier curve of constant
+    // radius. control point 3*v is vertex v and the two after it are
+    // the inner points of the link starting at v, so connected links
+    // share their end points (three control points per vertex)
+    const uint32 geomID = rtcNewHairGeometry(model->embreeSceneHandle,model->getGeometryFlags(),
+                                             numSegments,3*numVertices);
+
+    vec4f  *curveVertex = (vec4f *)rtcMapBuffer(model->embreeSceneHandle,geomID,RTC_VERTEX_BUFFER);
+    uint32 *curveIndex  = (uint32*)rtcMapBuffer(model->embreeSceneHandle,geomID,RTC_INDEX_BUFFER);
+    for (size_t v=0;v<numVertices;v++) {
+      const vec3fa P = vertex[v];
+      for (int j=0;j<3;j++)
+        curveVertex[3*v+j] = vec4f(P.x,P.y,P.z,radius);
+    }
+    for (size_t i=0;i<numSegments;i++) {
+      const vec3fa A = vertex[index[i]];
+      const vec3fa B = vertex[index[i]+1];
+      for (int j=1;j<3;j++) {
+        const vec3fa P = A + (j/3.f) * (B-A);
+        curveVertex[3*index[i]+j] = vec4f(P.x,P.y,P.z,radius);
+      }
+      curveIndex[i] = 3*index[i];
+    }
+    rtcUnmapBuffer(model->embreeSceneHandle,geomID,RTC_VERTEX_BUFFER);
+    rtcUnmapBuffer(model->embreeSceneHandle,geomID,RTC_INDEX_BUFFER);
+
+    ispc::StreamLineGeometry_setHair(getIE(),model->getIE(),geomID,radius,
+                                     (ispc::vec3fa*)vertex,numVertices,
+                                     (uint32_t*)index,numSegments,
+                                     (ispc::vec4f*)color);
   }
 
   OSP_REGISTER_GEOMETRY(StreamLines,streamlines);
@@ -65,6 +65,7 @@ namespace ospray {
     <dt><li><code>Data<vec3fa> vertex</code></dt><dd> Array of all vertices for *all* curves in this geometry, one curve's vertices stored after another.</dd>
     <dt><li><code>Data<int32>  index </code></dt><dd> index[i] specifies the index of the first vertex of the i'th curve. The curve then uses all following vertices in the 'vertex' array until either the next curve starts, or the array's end is reached.</dd>
     <dt><li><code>Data<vec3fa> color</code></dt><dd> Array of vertex colors corresponding to the vertices in this geometry.</dd>
+    <dt><code>int32        hair</code></dt><dd> If nonzero, each link is registered as an embree hair curve and intersected by embree's oriented bounding box hair BVH, instead of a user geometry primitive with per-link callbacks. Links are then intersected as ray facing ribbons without the rounded joints. Connected links share their end points, so the curves take three control points (48 bytes) per vertex. Default is 0.</dd>
     </dl>
 
     The functionality for this geometry is implemented via the
@@ -96,6 +97,7 @@ namespace ospray {
     size_t        numSegments;
     const vec4f  *color;
     float         radius;
+    bool          useHair; //!< links are embree hair curves
 
     StreamLines();
   };
@@ -31,35 +31,20 @@ namespace ospray {
   using std::cout;
   using std::endl;
 
-  inline bool inRange(int64 i, int64 i0, int64 i1)
-  {
-    return i >= i0 && i < i1;
-  }
-
   TriangleMesh::TriangleMesh() 
-    : eMesh(RTC_INVALID_ID)
+    : eMesh(RTC_INVALID_ID), numTris(0), numVerts(0),
+      numCompsInTri(0), numCompsInVtx(0), numCompsInNor(0),
+      octNormal(NULL), texcoord16(NULL),
+      texcoordLower(0.f), texcoordUpper(1.f),
+      indexModified(false), alphaTested(false)
   {
     this->ispcMaterialPtrs = NULL;
     this->ispcEquivalent = ispc::TriangleMesh_create(this);
   }
 
 
-  void TriangleMesh::finalize(Model *model)
+  void TriangleMesh::prepare(Model *model)
   {
-    static int numPrints = 0;
-    numPrints++;
-    if (logLevel >= 2) 
-      if (numPrints == 5)
-        cout << "(all future printouts for triangle mesh creation will be emitted)" << endl;
-    
-    if (logLevel >= 2) 
-      if (numPrints < 5)
-        std::cout << "ospray: finalizing triangle mesh ..." << std::endl;
-
-    Assert(model && "invalid model pointer");
-
-    RTCScene embreeSceneHandle = model->embreeSceneHandle;
-
     vertexData = getParamData("vertex",getParamData("position"));
     normalData = getParamData("vertex.normal",getParamData("normal"));
     colorData  = getParamData("vertex.color",getParamData("color"));
@@ -77,10 +62,16 @@ namespace ospray {
             " or 'triangle' array");
 
     this->index = (int*)indexData->data;
-    this->vertex = (float*)vertexData->data;
-    this->normal = normalData ? (float*)normalData->data : NULL;
     this->color  = colorData ? (vec4f*)colorData->data : NULL;
     this->texcoord = texcoordData ? (vec2f*)texcoordData->data : NULL;
+    this->texcoord16 = NULL;
+    if (texcoordData && texcoordData->type == OSP_USHORT2) {
+      // 16-bit unorm coordinates, mapped to [texcoord.lower,texcoord.upper]
+      this->texcoord = NULL;
+      this->texcoord16 = (uint16*)texcoordData->data;
+      texcoordLower = getParam2f("texcoord.lower",vec2f(0.f));
+      texcoordUpper = getParam2f("texcoord.upper",vec2f(1.f));
+    }
     this->prim_materialID  = prim_materialIDData ? (uint32*)prim_materialIDData->data : NULL;
     this->materialList  = materialListData ? (ospray::Material**)materialListData->data : NULL;
     
@@ -93,75 +84,125 @@ namespace ospray {
       }
     } 
 
-    size_t numTris  = -1;
-    size_t numVerts = -1;
-
-    size_t numCompsInTri = 0;
-    size_t numCompsInVtx = 0;
-    size_t numCompsInNor = 0;
+    numCompsInTri = 0;
     switch (indexData->type) {
     case OSP_INT:
-    case OSP_UINT:  numTris = indexData->size() / 3; numCompsInTri = 3; break;
+    case OSP_UINT:
+    case OSP_USHORT: numTris = indexData->size() / 3; numCompsInTri = 3; break;
     case OSP_INT3:
-    case OSP_UINT3: numTris = indexData->size(); numCompsInTri = 3; break;
+    case OSP_UINT3:
+    case OSP_USHORT3: numTris = indexData->size(); numCompsInTri = 3; break;
     case OSP_UINT4:
-    case OSP_INT4:  numTris = indexData->size(); numCompsInTri = 4; break;
+    case OSP_INT4:
+    case OSP_USHORT4: numTris = indexData->size(); numCompsInTri = 4; break;
     default:
       throw std::runtime_error("unsupported trianglemesh.index data type");
     }
+    if (indexData->type == OSP_USHORT || indexData->type == OSP_USHORT3
+        || indexData->type == OSP_USHORT4) {
+      // embree only takes 32-bit indices
+      decodedIndex.resize(3*numTris);
+      ispc::TriangleMesh_decodeIndices16((uint16*)indexData->data,numTris,
+                                         numCompsInTri,&decodedIndex[0]);
+      this->index = &decodedIndex[0];
+      numCompsInTri = 3;
+    } else {
+      decodedIndex.clear();
+    }
+
+    parseVertices();
+    parseNormals();
+
+#ifndef NDEBUG
+    if (!ispc::TriangleMesh_validateIndices((int*)index,numTris,numCompsInTri,numVerts))
+      throw std::runtime_error("vertex index not in range! (broken input model, refusing to handle that)");
+#endif
+
+    // SIMD reduction over all vertices, also detecting NaN coordinates
+    if (!ispc::TriangleMesh_computeBounds((float*)vertex,numVerts,numCompsInVtx,
+                                          (ispc::box3f&)bounds)) {
+#ifndef NDEBUG
+      throw std::runtime_error("NaN in vertex coordinate! (broken input model, refusing to handle that)");
+#endif
+    }
+  }
+
+  void TriangleMesh::parseVertices()
+  {
+    this->vertex = (float*)vertexData->data;
+    numCompsInVtx = 0;
     switch (vertexData->type) {
     case OSP_FLOAT:   numVerts = vertexData->size() / 4; numCompsInVtx = 4; break;
     case OSP_FLOAT3:  numVerts = vertexData->size(); numCompsInVtx = 3; break;
     case OSP_FLOAT3A: numVerts = vertexData->size(); numCompsInVtx = 4; break;
+    case OSP_USHORT3:
+    case OSP_USHORT4: {
+      // 16-bit unorm positions within [vertex.lower,vertex.upper];
+      // embree only takes float positions
+      const size_t numComps = (vertexData->type == OSP_USHORT3) ? 3 : 4;
+      const vec3f lower = getParam3f("vertex.lower",vec3f(0.f));
+      const vec3f upper = getParam3f("vertex.upper",vec3f(1.f));
+      numVerts = vertexData->size();
+      decodedVertex.resize(numVerts);
+      ispc::TriangleMesh_decodeVertices16((uint16*)vertexData->data,numVerts,numComps,
+                                          (ispc::vec3f&)lower,(ispc::vec3f&)upper,
+                                          (float*)&decodedVertex[0]);
+      this->vertex = (float*)&decodedVertex[0];
+      numCompsInVtx = 4;
+      return;
+    }
     default:
       throw std::runtime_error("unsupported trianglemesh.vertex data type");
     }
+    decodedVertex.clear();
+  }
+
+  void TriangleMesh::parseNormals()
+  {
+    this->normal = normalData ? (float*)normalData->data : NULL;
+    this->octNormal = NULL;
+    numCompsInNor = 0;
     if (normalData) switch (normalData->type) {
     case OSP_FLOAT3:  numCompsInNor = 3; break;
     case OSP_FLOAT:
     case OSP_FLOAT3A: numCompsInNor = 4; break;
+    case OSP_UINT:
+      // oct-encoded, decoded on the fly in postIntersect
+      this->normal = NULL;
+      this->octNormal = (uint32*)normalData->data;
+      break;
     default:
       throw std::runtime_error("unsupported trianglemesh.vertex.normal data type");
     }
+  }
 
-    eMesh = rtcNewTriangleMesh(embreeSceneHandle,RTC_GEOMETRY_STATIC,
+  void TriangleMesh::finalize(Model *model)
+  {
+    static int numPrints = 0;
+    numPrints++;
+    if (logLevel >= 2) 
+      if (numPrints == 5)
+        cout << "(all future printouts for triangle mesh creation will be emitted)" << endl;
+    
+    if (logLevel >= 2) 
+      if (numPrints < 5)
+        std::cout << "ospray: finalizing triangle mesh ..." << std::endl;
+
+    Assert(model && "invalid model pointer");
+
+    RTCScene embreeSceneHandle = model->embreeSceneHandle;
+    indexModified = false;
+
+    // meshes of a dynamic model may be refit after their vertices changed
+    eMesh = rtcNewTriangleMesh(embreeSceneHandle,model->getGeometryFlags(),
                                numTris,numVerts);
-#ifndef NDEBUG
-    {
-      cout << "#osp/trimesh: Verifying index buffer ... " << endl;
-      for (int i=0;i<numTris*numCompsInTri;i+=numCompsInTri) {
-        if (!inRange(index[i+0],0,numVerts) || 
-            !inRange(index[i+1],0,numVerts) || 
-            !inRange(index[i+2],0,numVerts))
-        {
-          PRINT(numTris);
-          PRINT(i);
-          PRINT(index[i]);
-          PRINT(numVerts);
-          throw std::runtime_error("vertex index not in range! (broken input model, refusing to handle that)");
-        }
-      }
-      cout << "#osp/trimesh: Verifying vertex buffer ... " << endl;
-      for (int i=0;i<numVerts*numCompsInVtx;i+=numCompsInVtx) {
-        if (std::isnan(vertex[i+0]) || 
-            std::isnan(vertex[i+1]) || 
-            std::isnan(vertex[i+2]))
-          throw std::runtime_error("NaN in vertex coordinate! (broken input model, refusing to handle that)");
-      }
-    }    
-#endif
 
     rtcSetBuffer(embreeSceneHandle,eMesh,RTC_VERTEX_BUFFER,
                  (void*)this->vertex,0,
-                 sizeOf(vertexData->type));
+                 numCompsInVtx*sizeof(float));
     rtcSetBuffer(embreeSceneHandle,eMesh,RTC_INDEX_BUFFER,
                  (void*)this->index,0,
-                 sizeOf(indexData->type));
-
-    bounds = embree::empty;
-    
-    for (int i=0;i<numVerts*numCompsInVtx;i+=numCompsInVtx) 
-      bounds.extend(*(vec3f*)(vertex + i));
+                 numCompsInTri*sizeof(int32));
 
     if (logLevel >= 2) 
       if (numPrints < 5) {
@@ -182,6 +223,86 @@ namespace ospray {
                            getMaterial()?getMaterial()->getIE():NULL,
                            ispcMaterialPtrs,
                            (uint32*)prim_materialID);
+    ispc::TriangleMesh_setCompactAttributes(getIE(),
+                                            (uint32*)octNormal,
+                                            (uint16*)texcoord16,
+                                            (ispc::vec2f&)texcoordLower,
+                                            (ispc::vec2f&)texcoordUpper);
+
+    // alpha test cut-out materials (e.g. foliage) during traversal,
+    // rather than having the renderer re-trace past each such hit
+    alphaTested = hasOpacityMap();
+    if (alphaTested)
+      ispc::TriangleMesh_enableAlphaTest(getIE(),model->getIE(),eMesh);
+  }
+
+  bool TriangleMesh::hasOpacityMap()
+  {
+    if (getMaterial() && getMaterial()->hasOpacityMap())
+      return true;
+    if (materialList)
+      for (size_t i = 0; i < materialListData->numItems; i++)
+        if (materialList[i]->hasOpacityMap())
+          return true;
+    return false;
+  }
+
+  void TriangleMesh::dependencyGotChanged(ManagedObject *object)
+  {
+    if (object == getParamData("index",getParamData("triangle")))
+      indexModified = true;
+    Geometry::dependencyGotChanged(object);
+  }
+
+  bool TriangleMesh::update(Model *model)
+  {
+    // only the vertex positions, normals and colors of a deformable
+    // mesh can change without creating a new embree geometry; indices
+    // edited in place and committed again change the topology, and
+    // adding or removing an opacity map changes the filter functions
+    Data *newVertexData = getParamData("vertex",getParamData("position"));
+    Data *newIndexData  = getParamData("index",getParamData("triangle"));
+    if (eMesh == RTC_INVALID_ID || !newVertexData || newIndexData != indexData.ptr || indexModified
+        || hasOpacityMap() != alphaTested
+        || newVertexData->type != vertexData->type || newVertexData->size() != vertexData->size())
+      return false;
+
+    vertexData = newVertexData;
+    normalData = getParamData("vertex.normal",getParamData("normal"));
+    colorData  = getParamData("vertex.color",getParamData("color"));
+
+    this->color  = colorData ? (vec4f*)colorData->data : NULL;
+
+    parseVertices();
+    parseNormals();
+
+    // the vertex buffer may have been replaced, the index buffer is unchanged
+    rtcSetBuffer(model->embreeSceneHandle,eMesh,RTC_VERTEX_BUFFER,
+                 (void*)this->vertex,0,
+                 numCompsInVtx*sizeof(float));
+    rtcUpdate(model->embreeSceneHandle,eMesh);
+
+    ispc::TriangleMesh_computeBounds((float*)vertex,numVerts,numCompsInVtx,
+                                     (ispc::box3f&)bounds);
+
+    ispc::TriangleMesh_set(getIE(),model->getIE(),eMesh,
+                           numTris,
+                           numCompsInTri,
+                           numCompsInNor,
+                           (int*)index,
+                           (float*)normal,
+                           (ispc::vec4f*)color,
+                           (ispc::vec2f*)texcoord,
+                           geom_materialID,
+                           getMaterial()?getMaterial()->getIE():NULL,
+                           ispcMaterialPtrs,
+                           (uint32*)prim_materialID);
+    ispc::TriangleMesh_setCompactAttributes(getIE(),
+                                            (uint32*)octNormal,
+                                            (uint16*)texcoord16,
+                                            (ispc::vec2f&)texcoordLower,
+                                            (ispc::vec2f&)texcoordUpper);
+    return true;
   }
 
 } // ::ospray
@@ -38,11 +38,37 @@ namespace ospray {
     Data<vec3f> or Data<vec3fa> "normal"          // vertex normals
     Data<vec4f>                 "color"           // vertex colors
     Data<vec2f>                 "texcoord"        // texture coordinates
+    </pre>
+
+    To reduce memory, some arrays may also be given in compact form
+    <pre>
+    Data<ushort3>               "index"           // 16-bit indices (for meshes with less than 64K vertices)
+    Data<ushort3> or Data<ushort4> "position"     // positions quantized to 16 bits within
+    vec3f                       "vertex.lower"    //   [vertex.lower,vertex.upper] (default [0,1])
+    vec3f                       "vertex.upper"
+    Data<uint>                  "normal"          // oct-encoded normals: two 16-bit snorm coordinates
+                                                  // (x in the lower, y in the upper half) of the normal
+                                                  // projected onto the octahedron
+    Data<ushort2>               "texcoord"        // texture coordinates quantized to 16 bits within
+    vec2f                       "texcoord.lower"  //   [texcoord.lower,texcoord.upper] (default [0,1])
+    vec2f                       "texcoord.upper"
+    </pre>
+    Normals and texture coordinates are decoded on the fly when a ray
+    hits the mesh; since embree only takes 32-bit indices and float
+    positions, compact indices and positions are decoded once when the
+    mesh is committed.
+
+    Other parameters:
+    <pre>
     uint32                      "geom.materialID" // material ID for the whole mesh
     Data<uint32>                "prim.materialID" // per triangle materials, indexing into "materialList"
     Data<OSPMaterial>           "materialList"    // list of OSPMaterial pointers
     </pre>
 
+    If the mesh's material has an opacity map (see
+    ospray::Material::hasOpacityMap), hits on its cut-out parts are
+    skipped during traversal already.
+
     The functionality for this geometry is implemented via the
     \ref ospray::TriangleMesh class.
   */
@@ -74,7 +100,18 @@ namespace ospray {
 
     TriangleMesh();
     virtual std::string toString() const { return "ospray::TriangleMesh"; }
+    virtual void prepare(Model *model);
     virtual void finalize(Model *model);
+    virtual bool update(Model *model);
+    //! also notes whether the index array got committed, which needs a full finalize
+    virtual void dependencyGotChanged(ManagedObject *object);
+
+    //! set vertex, numVerts and numCompsInVtx from vertexData, decoding quantized positions
+    void parseVertices();
+    //! set normal (or octNormal) and numCompsInNor from normalData
+    void parseNormals();
+    //! whether the mesh's material or any in its materialList has an opacity map
+    bool hasOpacityMap();
 
     const int    *index;  //!< mesh's triangle index array
     const float  *vertex; //!< mesh's vertex array
@@ -84,6 +121,12 @@ namespace ospray {
     const uint32 *prim_materialID; //!< per-primitive material ID
     Material **materialList; //!< per-primitive material list
     int geom_materialID;
+    const uint32 *octNormal;  //!< oct-encoded vertex normals, used instead of 'normal'
+    const uint16 *texcoord16; //!< quantized texcoords, used instead of 'texcoord'
+    vec2f texcoordLower; //!< texcoord of quantized value 0
+    vec2f texcoordUpper; //!< texcoord of quantized value 65535
+    std::vector<int32> decodedIndex;   //!< 16-bit indices widened for embree
+    std::vector<vec3fa> decodedVertex; //!< quantized positions decoded for embree
 
     Ref<Data> indexData;  /*!< triangle indices (A,B,C,materialID) */
     Ref<Data> vertexData; /*!< vertex position (vec3fa) */
@@ -93,6 +136,13 @@ namespace ospray {
     Ref<Data> prim_materialIDData;  /*!< data array for per-prim material ID (uint32) */
     Ref<Data> materialListData; /*!< data array for per-prim materials */
     uint32    eMesh;   /*!< embree triangle mesh handle */
+    size_t    numTris;  /*!< number of triangles registered with embree */
+    size_t    numVerts; /*!< number of vertices registered with embree */
+    size_t    numCompsInTri; /*!< number of int32 per triangle in the index array */
+    size_t    numCompsInVtx; /*!< number of floats per vertex in the vertex array */
+    size_t    numCompsInNor; /*!< number of floats per normal in the normal array */
+    bool      indexModified; /*!< the index array got committed since the mesh was finalized */
+    bool      alphaTested;   /*!< the alpha test filter functions got registered at the last finalize */
 
     void** ispcMaterialPtrs; /*!< pointers to ISPC equivalent materials */
   };
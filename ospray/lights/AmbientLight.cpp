@@ -33,6 +33,9 @@ namespace ospray {
     vec3f radiance = color * intensity;
     
     ispc::AmbientLight_set(getIE(), (ispc::vec3f&)radiance);
+
+    // renderers may cache the lighting, e.g. in illumination grids
+    notifyListenersThatObjectGotChanged();
   }
 
   OSP_REGISTER_LIGHT(AmbientLight, AmbientLight);
@@ -35,6 +35,9 @@ namespace ospray {
     vec3f radiance = color * intensity;
 
     ispc::DirectionalLight_set(getIE(), (ispc::vec3f&)direction, (ispc::vec3f&)radiance);
+
+    // renderers may cache the lighting, e.g. in illumination grids
+    notifyListenersThatObjectGotChanged();
   }
 
   OSP_REGISTER_LIGHT(DirectionalLight, DirectionalLight);
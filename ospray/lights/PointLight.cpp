@@ -37,6 +37,9 @@ namespace ospray {
     vec3f power = color * intensity;
 
     ispc::PointLight_set(getIE(), (ispc::vec3f&)position, (ispc::vec3f&)power, range);
+
+    // renderers may cache the lighting, e.g. in illumination grids
+    notifyListenersThatObjectGotChanged();
   }
 
   OSP_REGISTER_LIGHT(PointLight, PointLight);
@@ -46,6 +46,9 @@ namespace ospray {
                         (ispc::vec3f&)power,
                         cos(halfAngle * (M_PI / 180.0f)),
                         range);
+
+    // renderers may cache the lighting, e.g. in illumination grids
+    notifyListenersThatObjectGotChanged();
   }
 
   OSP_REGISTER_LIGHT(SpotLight, SpotLight);
@@ -48,6 +48,9 @@ namespace ospray {
                             map_Ns ? map_Ns->getIE() : NULL,
                             Ns,
                             map_Bump != NULL ? map_Bump->getIE() : NULL );
+
+      // geometries using this material may have to change their alpha test
+      notifyListenersThatObjectGotChanged();
     }
 
     OSP_REGISTER_MATERIAL(OBJMaterial,OBJMaterial);
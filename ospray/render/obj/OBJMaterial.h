@@ -38,6 +38,10 @@ namespace ospray {
 
       //! \brief commit the material's parameters
       virtual void commit();
+
+      /*! opacity map or diffuse map with alpha channel */
+      virtual bool hasOpacityMap() const
+      { return map_d || (map_Kd && map_Kd->type == OSP_UCHAR4); }
     };
 
   } // ::ospray::obj
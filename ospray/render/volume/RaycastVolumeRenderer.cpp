@@ -15,8 +15,11 @@
 // ======================================================================== //
 
 // ospray
+#include "ospray/camera/PerspectiveCamera.h"
 #include "ospray/lights/Light.h"
 #include "ospray/common/Data.h"
+#include "ospray/common/Model.h"
+#include "ospray/volume/Volume.h"
 #include "ospray/render/volume/RaycastVolumeRenderer.h"
 // ispc exports
 #include "RaycastVolumeRenderer_ispc.h"
@@ -51,8 +54,74 @@ namespace ospray {
     // Set the lights if any.
     ispc::RaycastVolumeRenderer_setLights(ispcEquivalent, getLightsFromData(getParamData("lights", NULL)));
 
+    // Rays are terminated once their accumulated opacity reaches this threshold.
+    ispc::RaycastVolumeRenderer_setEarlyTerminationThreshold(ispcEquivalent, getParam1f("earlyTerminationThreshold", 0.99f));
+
+    // Adapt the sampling rate along each ray to the sampled opacity, within the given bounds.
+    const float adaptiveMinSamplingRate = getParam1f("adaptiveMinSamplingRate", 0.25f);
+    const float adaptiveMaxSamplingRate = getParam1f("adaptiveMaxSamplingRate", 2.0f);
+    exitOnCondition(adaptiveMinSamplingRate <= 0.0f || adaptiveMaxSamplingRate < adaptiveMinSamplingRate, "invalid adaptive sampling rate bounds");
+
+    ispc::RaycastVolumeRenderer_setAdaptiveSampling(ispcEquivalent,
+                                                    getParam1i("adaptiveSampling", 0),
+                                                    getParam1f("adaptiveScalar", 15.0f),
+                                                    adaptiveMinSamplingRate,
+                                                    adaptiveMaxSamplingRate);
+
     // Initialize state in the parent class, must be called after the ISPC object is created.
     Renderer::commit();
+
+    // Optionally precompute low resolution grids of shadowed illumination from all lights, computed before the next frame.
+    illuminationGridResolution = getParam1i("illuminationGridResolution", 0);
+    illuminationGridsModified = true;
+  }
+
+  RaycastVolumeRenderer::~RaycastVolumeRenderer()
+  {
+    for (size_t i=0 ; i < illuminationDependencies.size() ; i++) illuminationDependencies[i]->unregisterListener(this);
+  }
+
+  void RaycastVolumeRenderer::beginFrame(FrameBuffer *fb)
+  {
+    // The grids are keyed to the volumes of the model, rebuild them after any change.
+    if (illuminationGridsModified) updateIlluminationGrids();
+
+    // The field of view of the camera as of this frame determines the sample footprint used to select the level of
+    // detail in multi-resolution volumes.  Other cameras have no such footprint, volumes are sampled at full resolution.
+    PerspectiveCamera *camera = dynamic_cast<PerspectiveCamera *>(getParamObject("camera", NULL));
+    ispc::RaycastVolumeRenderer_setFieldOfView(ispcEquivalent, camera ? camera->fovy * float(M_PI) / 180.0f : 0.0f);
+
+    Renderer::beginFrame(fb);
+  }
+
+  void RaycastVolumeRenderer::dependencyGotChanged(ManagedObject *object)
+  {
+    illuminationGridsModified = true;
+  }
+
+  void RaycastVolumeRenderer::updateIlluminationGrids()
+  {
+    for (size_t i=0 ; i < illuminationDependencies.size() ; i++) illuminationDependencies[i]->unregisterListener(this);
+    illuminationDependencies.clear();
+
+    // The grids depend on the model volumes and their transfer functions, and on the lights.
+    if (illuminationGridResolution >= 2 && model) {
+      illuminationDependencies.push_back(model);
+
+      for (size_t i=0 ; i < model->volumes.size() ; i++) {
+        illuminationDependencies.push_back(model->volumes[i].ptr);
+        ManagedObject *transferFunction = model->volumes[i]->getParamObject("transferFunction", NULL);
+        if (transferFunction) illuminationDependencies.push_back(transferFunction);
+      }
+
+      Data *lights = getParamData("lights", NULL);
+      for (size_t i=0 ; lights && i < lights->numItems ; i++) illuminationDependencies.push_back(((ManagedObject **) lights->data)[i]);
+    }
+
+    for (size_t i=0 ; i < illuminationDependencies.size() ; i++) illuminationDependencies[i]->registerListener(this);
+
+    ispc::RaycastVolumeRenderer_setIlluminationGridResolution(ispcEquivalent, illuminationGridResolution);
+    illuminationGridsModified = false;
   }
 
   void **RaycastVolumeRenderer::getLightsFromData(const Data *buffer)
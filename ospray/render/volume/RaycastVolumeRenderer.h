@@ -39,10 +39,10 @@ namespace ospray {
   public:
 
     //! Constructor.
-    RaycastVolumeRenderer() {};
+    RaycastVolumeRenderer() : illuminationGridResolution(0), illuminationGridsModified(false) {};
 
     //! Destructor.
-    ~RaycastVolumeRenderer() {};
+    ~RaycastVolumeRenderer();
 
     //! Create a material of the given type.
     Material * createMaterial(const char *type) { return new Material; }
@@ -50,6 +50,13 @@ namespace ospray {
     //! Initialize the renderer state, and create the equivalent ISPC volume renderer object.
     virtual void commit();
 
+    //! Rebuild the illumination grids if the model, its volumes, or the lights changed since they were computed, and
+    //! take the sample footprint from the current camera field of view.
+    virtual void beginFrame(FrameBuffer *fb);
+
+    //! Mark the illumination grids out of date.
+    virtual void dependencyGotChanged(ManagedObject *object);
+
     //! A string description of this class.
     virtual std::string toString() const { return("ospray::RaycastVolumeRenderer"); }
 
@@ -66,6 +73,18 @@ namespace ospray {
     //! Gather pointers to the ISPC equivalents from an array of Light objects.
     void **getLightsFromData(const Data *buffer);
 
+    //! Compute the illumination grids for the current model and listen for changes of the objects they depend on.
+    void updateIlluminationGrids();
+
+    //! Illumination grid size in grid points per dimension (0 if disabled).
+    int32 illuminationGridResolution;
+
+    //! The illumination grids are out of date.
+    bool illuminationGridsModified;
+
+    //! The model, volumes, transfer functions and lights the illumination grids were computed from.
+    std::vector<Ref<ManagedObject> > illuminationDependencies;
+
   };
 
 } // ::ospray
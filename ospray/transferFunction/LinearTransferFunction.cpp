@@ -38,6 +38,10 @@ namespace ospray {
     // Set the value range that the transfer function covers.
     vec2f valueRange = getParam2f("valueRange", vec2f(0.0f, 1.0f));  ispc::TransferFunction_setValueRange(ispcEquivalent, (const ispc::vec2f &) valueRange);
 
+    // Optionally build the pre-integration table, once the colors, opacities and value range are current.
+    const int tableSize = getParam1i("preIntegration", 0) ? getParam1i("preIntegrationTableSize", 256) : 0;
+    ispc::LinearTransferFunction_setPreIntegration(ispcEquivalent, tableSize);
+
     // Notify listeners that the transfer function has changed.
     notifyListenersThatObjectGotChanged();
   }
@@ -0,0 +1,266 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+#include "ospray/volume/AMRVolume.h"
+#include "AMRVolume_ispc.h"
+// stl
+#include <algorithm>
+#include <cmath>
+
+namespace ospray {
+
+  //! Orders brick indices by descending refinement level.
+  struct LevelDescending {
+    LevelDescending(const std::vector<int32> &levels) : levels(levels) {}
+    bool operator()(size_t a, size_t b) const { return(levels[a] > levels[b]); }
+    const std::vector<int32> &levels;
+  };
+
+  AMRVolume::~AMRVolume()
+  {
+    // No longer listen for changes of the brick data.
+    for (size_t i = 0 ; i < dependencies.size() ; i++) dependencies[i]->unregisterListener(this);
+
+    // Free the brick array, the ISPC container itself is freed by ~ManagedObject.
+    if (ispcEquivalent != NULL) ispc::AMRVolume_destroy(ispcEquivalent);
+  }
+
+  void AMRVolume::commit()
+  {
+    // Create the equivalent ISPC volume container.
+    if (ispcEquivalent == NULL) createEquivalentISPC();
+
+    // Some parameters can be changed after the volume has been committed.
+    updateEditableParameters();
+
+    // The bricks are read and indexed again only if their description or the level geometry changed.
+    if (!brickData || bricksModified
+        || getParamData("brickInfo", NULL) != brickInfo.ptr || getParamData("brickData", NULL) != brickData.ptr
+        || getParamData("refinementRatio", NULL) != refinementRatios.ptr || getParam1i("refinementRatio", 2) != refinementRatio
+        || getParam3f("gridOrigin", vec3f(0.f)) != gridOrigin || getParam3f("gridSpacing", vec3f(1.f)) != gridSpacing) {
+      buildBricks();
+
+      // Volume finish actions.
+      finish();
+    }
+
+    // Geometries referring to this volume are finalized again with their models.
+    notifyListenersThatObjectGotChanged();
+  }
+
+  void AMRVolume::dependencyGotChanged(ManagedObject *object)
+  {
+    bricksModified = true;
+  }
+
+  void AMRVolume::buildBricks()
+  {
+    brickInfo = getParamData("brickInfo", NULL);
+    brickData = getParamData("brickData", NULL);
+    exitOnCondition(!brickInfo || brickInfo->type != OSP_INT || brickInfo->numItems % 7 != 0, "no valid brickInfo specified");
+    exitOnCondition(!brickData || brickData->type != OSP_OBJECT, "no valid brickData specified");
+
+    const size_t brickCount = brickInfo->numItems / 7;
+    exitOnCondition(brickCount == 0 || brickData->numItems != brickCount, "brickInfo and brickData sizes do not match");
+
+    gridOrigin = getParam3f("gridOrigin", vec3f(0.f));
+    gridSpacing = getParam3f("gridSpacing", vec3f(1.f));
+    refinementRatio = getParam1i("refinementRatio", 2);
+    refinementRatios = getParamData("refinementRatio", NULL);
+    exitOnCondition(refinementRatios && refinementRatios->type != OSP_INT, "refinementRatio array must hold integers");
+    exitOnCondition(!refinementRatios && refinementRatio < 1, "invalid refinementRatio");
+
+    // Listen for changes of the data arrays.
+    for (size_t i = 0 ; i < dependencies.size() ; i++) dependencies[i]->unregisterListener(this);
+    dependencies.clear();
+    dependencies.push_back(brickInfo.ptr);
+    dependencies.push_back(brickData.ptr);
+    if (refinementRatios) dependencies.push_back(refinementRatios.ptr);
+    bricksModified = false;
+
+    std::vector<box3f> bounds(brickCount);
+    std::vector<vec3f> cellWidths(brickCount);
+    std::vector<vec3i> dimensions(brickCount);
+    std::vector<int32> levels(brickCount);
+    std::vector<float *> values(brickCount);
+    int32 levelCount = 0;
+
+    for (size_t i = 0 ; i < brickCount ; i++) {
+      const int32 level = ((const int32 *) brickInfo->data)[7 * i + 6];
+      exitOnCondition(level < 0, "invalid brickInfo entry");
+      levelCount = std::max(levelCount, level + 1);
+    }
+
+    // Cell width of each level, the ratio between a level and the next may differ per level.
+    std::vector<vec3f> levelCellWidths(levelCount, gridSpacing);
+    exitOnCondition(refinementRatios && refinementRatios->numItems + 1 < size_t(levelCount), "refinementRatio array holds fewer entries than there are level transitions");
+    for (int32 level = 1 ; level < levelCount ; level++) {
+      const int32 ratio = refinementRatios ? ((const int32 *) refinementRatios->data)[level - 1] : refinementRatio;
+      exitOnCondition(ratio < 1, "invalid refinementRatio");
+      levelCellWidths[level] = levelCellWidths[level - 1] / float(ratio);
+    }
+
+    for (size_t i = 0 ; i < brickCount ; i++) {
+
+      const int32 *info = (const int32 *) brickInfo->data + 7 * i;
+      const vec3i lower(info[0], info[1], info[2]);
+      const vec3i upper(info[3], info[4], info[5]);
+      levels[i] = info[6];
+      exitOnCondition(upper.x < lower.x || upper.y < lower.y || upper.z < lower.z, "invalid brickInfo entry");
+
+      // Brick size in cells and bounds in world coordinates.
+      cellWidths[i] = levelCellWidths[levels[i]];
+      dimensions[i] = upper - lower + vec3i(1);
+      bounds[i] = box3f(gridOrigin + vec3f(lower) * cellWidths[i], gridOrigin + vec3f(upper + vec3i(1)) * cellWidths[i]);
+
+      Data *brick = ((Data **) brickData->data)[i];
+      exitOnCondition(brick == NULL || brick->type != OSP_FLOAT || brick->numItems != size_t(dimensions[i].x) * dimensions[i].y * dimensions[i].z,
+                      "brickData entry does not match its brickInfo");
+      values[i] = (float *) brick->data;
+      dependencies.push_back(brick);
+    }
+
+    for (size_t i = 0 ; i < dependencies.size() ; i++) dependencies[i]->registerListener(this);
+
+    // Set the bricks, computing the value range of each brick in parallel.
+    brickRanges.resize(brickCount);
+    ispc::AMRVolume_setBricks(ispcEquivalent, brickCount,
+                              (const ispc::box3f *) &bounds[0],
+                              (const ispc::vec3f *) &cellWidths[0],
+                              (const ispc::vec3i *) &dimensions[0],
+                              &levels[0], &values[0],
+                              (ispc::vec2f *) &brickRanges[0]);
+
+    // Index the bricks and set up space skipping.
+    buildIndex(bounds, levels);
+    computeSkipRanges(bounds, levels);
+    ispc::AMRVolume_setIndex(ispcEquivalent,
+                             (const ispc::vec3f &) indexOrigin,
+                             (const ispc::vec3f &) indexCellSize,
+                             (const ispc::vec3i &) indexDimensions,
+                             &indexOffsets[0], &indexBrickIDs[0],
+                             (ispc::vec2f *) &skipRanges[0]);
+
+    // Make the voxel value range visible to the application.
+    vec2f voxelRange(brickRanges[0]);
+    for (size_t i = 1 ; i < brickCount ; i++) voxelRange = vec2f(std::min(voxelRange.x, brickRanges[i].x), std::max(voxelRange.y, brickRanges[i].y));
+    set("voxelRange", voxelRange);
+  }
+
+  int AMRVolume::setRegion(const void *source, const vec3i &index, const vec3i &count)
+  {
+    exitOnCondition(true, "setRegion() not allowed on this volume type; "
+                    "volume data must be provided via the brickData parameter");
+    return 0;
+  }
+
+  void AMRVolume::createEquivalentISPC()
+  {
+    // Create an ISPC AMRVolume object.
+    ispcEquivalent = ispc::AMRVolume_createInstance(this);
+  }
+
+  void AMRVolume::buildIndex(const std::vector<box3f> &bounds, const std::vector<int32> &levels)
+  {
+    // The index grid covers the union of the brick bounds with cells about the size of the average level 0 brick.
+    box3f domain = bounds[0];
+    vec3f brickSize(0.f);
+    size_t coarseCount = 0;
+
+    for (size_t i = 0 ; i < bounds.size() ; i++) {
+      domain.extend(bounds[i]);
+      if (levels[i] == 0) { brickSize += bounds[i].size();  coarseCount++; }
+    }
+
+    const vec3f extent = domain.size();
+    if (coarseCount > 0) brickSize /= float(coarseCount);
+    else brickSize = extent;
+
+    indexOrigin = domain.lower;
+    indexDimensions = vec3i(std::min(std::max(int32(ceilf(extent.x / brickSize.x)), 1), 128),
+                            std::min(std::max(int32(ceilf(extent.y / brickSize.y)), 1), 128),
+                            std::min(std::max(int32(ceilf(extent.z / brickSize.z)), 1), 128));
+    indexCellSize = extent / vec3f(indexDimensions);
+
+    // Index cells overlapped by each brick.
+    std::vector<vec3i> firstCell(bounds.size()), lastCell(bounds.size());
+    for (size_t i = 0 ; i < bounds.size() ; i++) {
+      const vec3f lower = (bounds[i].lower - indexOrigin) / indexCellSize;
+      const vec3f upper = (bounds[i].upper - indexOrigin) / indexCellSize;
+      firstCell[i] = vec3i(std::max(int32(floorf(lower.x)), 0), std::max(int32(floorf(lower.y)), 0), std::max(int32(floorf(lower.z)), 0));
+      lastCell[i] = vec3i(std::min(int32(floorf(upper.x)), indexDimensions.x - 1),
+                          std::min(int32(floorf(upper.y)), indexDimensions.y - 1),
+                          std::min(int32(floorf(upper.z)), indexDimensions.z - 1));
+    }
+
+    // Bricks are listed finest level first, so the first brick containing a location is the finest one.
+    std::vector<size_t> order(bounds.size());
+    for (size_t i = 0 ; i < order.size() ; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), LevelDescending(levels));
+
+    // Count the bricks per index cell, then fill the lists.
+    const size_t cellCount = size_t(indexDimensions.x) * indexDimensions.y * indexDimensions.z;
+    indexOffsets.assign(cellCount + 1, 0);
+
+    for (int32 pass = 0 ; pass < 2 ; pass++) {
+
+      std::vector<int64> cursor(indexOffsets);
+
+      for (size_t k = 0 ; k < order.size() ; k++) {
+        const size_t i = order[k];
+        for (int32 z = firstCell[i].z ; z <= lastCell[i].z ; z++)
+          for (int32 y = firstCell[i].y ; y <= lastCell[i].y ; y++)
+            for (int32 x = firstCell[i].x ; x <= lastCell[i].x ; x++) {
+              const size_t cell = x + indexDimensions.x * (y + size_t(indexDimensions.y) * z);
+              if (pass == 0) indexOffsets[cell + 1]++;
+              else indexBrickIDs[cursor[cell]++] = int32(i);
+            }
+      }
+
+      if (pass == 0) {
+        for (size_t cell = 0 ; cell < cellCount ; cell++) indexOffsets[cell + 1] += indexOffsets[cell];
+        indexBrickIDs.resize(std::max(indexOffsets.back(), int64(1)));
+      }
+    }
+  }
+
+  void AMRVolume::computeSkipRanges(const std::vector<box3f> &bounds, const std::vector<int32> &levels)
+  {
+    skipRanges = brickRanges;
+
+    // A brick is sampled wherever no finer brick covers it, but the ranges of the finer bricks it overlaps keep
+    // the skipping conservative where the finest brick found at a sample location is entered mid-step.
+    for (size_t i = 0 ; i < bounds.size() ; i++) {
+
+      const vec3f lower = (bounds[i].lower - indexOrigin) / indexCellSize;
+      const vec3f upper = (bounds[i].upper - indexOrigin) / indexCellSize;
+
+      for (int32 z = std::max(int32(floorf(lower.z)), 0) ; z <= std::min(int32(floorf(upper.z)), indexDimensions.z - 1) ; z++)
+        for (int32 y = std::max(int32(floorf(lower.y)), 0) ; y <= std::min(int32(floorf(upper.y)), indexDimensions.y - 1) ; y++)
+          for (int32 x = std::max(int32(floorf(lower.x)), 0) ; x <= std::min(int32(floorf(upper.x)), indexDimensions.x - 1) ; x++) {
+
+            const size_t cell = x + indexDimensions.x * (y + size_t(indexDimensions.y) * z);
+
+            // The finer bricks come first in the list of the cell.
+            for (int64 j = indexOffsets[cell] ; j < indexOffsets[cell + 1] && levels[indexBrickIDs[j]] > levels[i] ; j++) {
+              if (disjoint(bounds[i], bounds[indexBrickIDs[j]])) continue;
+              skipRanges[i].x = std::min(skipRanges[i].x, brickRanges[indexBrickIDs[j]].x);
+              skipRanges[i].y = std::max(skipRanges[i].y, brickRanges[indexBrickIDs[j]].y);
+            }
+          }
+    }
+  }
+
+} // ::ospray
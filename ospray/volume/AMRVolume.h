@@ -0,0 +1,111 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+#pragma once
+
+#include "ospray/common/Data.h"
+#include "ospray/volume/Volume.h"
+// stl
+#include <vector>
+
+namespace ospray {
+
+  //! \brief A Volume over block-structured adaptive mesh refinement data.
+  //!
+  //!  The volume is given as a set of bricks of cell-centered values,
+  //!  each at some refinement level.  The "brickInfo" parameter holds 7
+  //!  integers per brick: the inclusive lower and upper cell index of
+  //!  the brick in the index space of its level, and the level.  The
+  //!  "brickData" parameter holds one float data array per brick in XYZ
+  //!  order.  Cells of level 0 are "gridSpacing" wide, each finer level
+  //!  divides the cell width by "refinementRatio", either one integer
+  //!  for all levels or an integer array holding the ratio between each
+  //!  level and the next.  Samples are taken from the finest brick
+  //!  covering a location, located through a uniform index grid listing
+  //!  the bricks of all levels overlapping each index cell, finest
+  //!  first.  Bricks whose values (including those of the finer bricks
+  //!  they overlap) are fully transparent are skipped.  The bricks are
+  //!  indexed again on commit when these parameters, or the data arrays
+  //!  they refer to, changed.
+  //!
+  class AMRVolume : public Volume {
+  public:
+
+    //! Constructor.
+    AMRVolume() : refinementRatio(0), bricksModified(false) {};
+
+    //! Destructor.
+    virtual ~AMRVolume();
+
+    //! A string description of this class.
+    virtual std::string toString() const { return("ospray::AMRVolume"); }
+
+    //! Allocate storage and populate the volume, called through the OSPRay API.
+    virtual void commit();
+
+    //! Copy voxels into the volume at the given index; not allowed on AMRVolume.
+    virtual int setRegion(const void *source, const vec3i &index, const vec3i &count);
+
+    //! Index the bricks again on the next commit when the brick or refinement ratio arrays got committed.
+    virtual void dependencyGotChanged(ManagedObject *object);
+
+  protected:
+
+    //! Create the equivalent ISPC volume container.
+    virtual void createEquivalentISPC();
+
+    //! Read the bricks and build the index and space skipping structures.
+    void buildBricks();
+
+    //! Build the index grid locating the bricks overlapping each index cell.
+    void buildIndex(const std::vector<box3f> &bounds, const std::vector<int32> &levels);
+
+    //! Widen the value range of each brick by the ranges of the finer bricks it overlaps.
+    void computeSkipRanges(const std::vector<box3f> &bounds, const std::vector<int32> &levels);
+
+    //! Brick description and value data at the last build, referenced to keep the brick values alive.
+    Ref<Data> brickInfo;
+    Ref<Data> brickData;
+
+    //! Level geometry at the last build.
+    vec3f gridOrigin;
+    vec3f gridSpacing;
+    int32 refinementRatio;
+    Ref<Data> refinementRatios;
+
+    //! The data arrays the bricks were built from, this volume listens for their changes.
+    std::vector<Ref<ManagedObject> > dependencies;
+
+    //! Indicate that one of the data arrays got committed since the last build.
+    bool bricksModified;
+
+    //! Index grid origin, cell size and size in cells per dimension.
+    vec3f indexOrigin;
+    vec3f indexCellSize;
+    vec3i indexDimensions;
+
+    //! Offsets into indexBrickIDs of the bricks overlapping each index cell.
+    std::vector<int64> indexOffsets;
+
+    //! Brick IDs listed per index cell, finest level first.
+    std::vector<int32> indexBrickIDs;
+
+    //! Value range of each brick, and the range used for space skipping.
+    std::vector<vec2f> brickRanges;
+    std::vector<vec2f> skipRanges;
+
+  };
+
+} // ::ospray
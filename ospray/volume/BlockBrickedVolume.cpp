@@ -48,22 +48,21 @@ namespace ospray {
     // Create the equivalent ISPC volume container and allocate memory for voxel data.
     if (ispcEquivalent == NULL) createEquivalentISPC();
 
-    /*! \todo check if we still need this 'computevoxelrange' - in
-        theory we need this only if the app is allowed to query these
-        values, and they're not being set in sharedstructuredvolume,
-        either, so should we actually set them at all!? */
-    // Compute the voxel value range for float voxels if none was previously specified.
-    if (voxelType == "float" && findParam("voxelRange") == NULL) 
-      computeVoxelRange((float *) source, size_t(regionSize.x) * regionSize.y * regionSize.z);
-    
-    // Compute the voxel value range for unsigned byte voxels if none was previously specified.
-    if (voxelType == "uchar" && findParam("voxelRange") == NULL) 
-      computeVoxelRange((unsigned char *) source, size_t(regionSize.x) * regionSize.y * regionSize.z);
-    
-    // Copy voxel data into the volume.
+    // Copy voxel data into the volume, computing the value range of the copied voxels in the same parallel pass.
+    vec2f regionRange;
     ispc::BlockBrickedVolume_setRegion(ispcEquivalent, source, 
                                        (const ispc::vec3i &) regionCoords, 
-                                       (const ispc::vec3i &) regionSize);
+                                       (const ispc::vec3i &) regionSize,
+                                       (ispc::vec2f &) regionRange);
+
+    // Update the voxel value range if none was previously specified.
+    if (computesVoxelRange()) {
+      voxelRange.x = std::min(voxelRange.x, regionRange.x);
+      voxelRange.y = std::max(voxelRange.y, regionRange.y);
+    }
+
+    // The acceleration structure covering the region is updated on the next commit.
+    markRegionDirty(regionCoords, regionSize);
     return true;
   }
 
@@ -0,0 +1,83 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+//ospray
+#include "ospray/volume/MultiResolutionVolume.h"
+#include "MultiResolutionVolume_ispc.h"
+// std
+#include <cassert>
+
+namespace ospray {
+
+  MultiResolutionVolume::~MultiResolutionVolume()
+  {
+    // Free the downsampled levels, the ISPC container itself is freed by ~ManagedObject.
+    if (ispcEquivalent != NULL) ispc::MultiResolutionVolume_destroyLevels(ispcEquivalent);
+  }
+
+  void MultiResolutionVolume::commit()
+  {
+    // BlockBrickedVolume commit actions.
+    BlockBrickedVolume::commit();
+
+    // Scale applied to the ray footprint before the level of detail is selected (larger values favor coarser levels).
+    ispc::MultiResolutionVolume_setLevelOfDetailScale(ispcEquivalent, getParam1f("levelOfDetailScale", 1.0f));
+
+    // (Re)build the level pyramid if the voxel data changed, otherwise only update the grid definition of each level.
+    if (levelsDirty) {
+
+      // The number of levels including the full resolution level, by default until the coarsest level fits into a single brick.
+      const int levelCount = getParam1i("levelCount", 0);
+      exitOnCondition(levelCount < 0, "invalid level count");
+
+      ispc::MultiResolutionVolume_buildLevels(ispcEquivalent, levelCount);
+      levelsDirty = false;
+
+    } else
+      ispc::MultiResolutionVolume_updateLevels(ispcEquivalent);
+
+    // Make the number of levels visible to the application.
+    set("levelCount", ispc::MultiResolutionVolume_getLevelCount(ispcEquivalent));
+  }
+
+  int MultiResolutionVolume::setRegion(const void *source, const vec3i &index, const vec3i &count)
+  {
+    // The downsampled levels are rebuilt on the next commit.
+    levelsDirty = true;
+
+    // BlockBrickedVolume setRegion actions.
+    return(BlockBrickedVolume::setRegion(source, index, count));
+  }
+
+  void MultiResolutionVolume::createEquivalentISPC()
+  {
+    // Get the voxel type.
+    voxelType = getParamString("voxelType", "unspecified");
+    exitOnCondition(getVoxelType() == OSP_UNKNOWN, "unrecognized voxel type (must be set before calling ospSetRegion())");
+
+    // Get the volume dimensions.
+    this->dimensions = getParam3i("dimensions", vec3i(0));
+    exitOnCondition(reduce_min(this->dimensions) <= 0,
+                    "invalid volume dimensions (must be set before calling ospSetRegion())");
+
+    // Create an ISPC MultiResolutionVolume object and assign type-specific function pointers.
+    ispcEquivalent = ispc::MultiResolutionVolume_createInstance(this,
+                                                                (int)getVoxelType(),
+                                                                (const ispc::vec3i &)this->dimensions);
+  }
+
+} // ::ospray
+
@@ -0,0 +1,60 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "ospray/volume/BlockBrickedVolume.h"
+
+namespace ospray {
+
+  //! \brief A concrete implementation of the BlockBrickedVolume class
+  //!  which additionally keeps a pyramid of downsampled copies of the
+  //!  voxel data, each level stored as a BlockBrickedVolume.
+  //!
+  //!  Ray casting renderers select the level of detail, and the
+  //!  matching sampling step size, from the footprint of the ray.  The
+  //!  pyramid is built on commit whenever the voxel data has changed.
+  //!
+  class MultiResolutionVolume : public BlockBrickedVolume {
+  public:
+
+    //! Constructor.
+    MultiResolutionVolume() : levelsDirty(true) {};
+
+    //! Destructor.
+    virtual ~MultiResolutionVolume();
+
+    //! A string description of this class.
+    virtual std::string toString() const { return("ospray::MultiResolutionVolume<" + voxelType + ">"); }
+
+    //! Allocate storage and populate the volume, called through the OSPRay API.
+    virtual void commit();
+
+    //! Copy voxels into the volume at the given index (non-zero return value indicates success).
+    virtual int setRegion(const void *source, const vec3i &index, const vec3i &count);
+
+  protected:
+
+    //! Create the equivalent ISPC volume container.
+    virtual void createEquivalentISPC();
+
+    //! Indicate that the voxel data changed since the level pyramid was built.
+    bool levelsDirty;
+
+  };
+
+} // ::ospray
+
@@ -88,9 +88,30 @@ namespace ospray {
 
   void SharedStructuredVolume::dependencyGotChanged(ManagedObject *object)
   {
-    // Rebuild volume accelerator when voxelData is committed.
-    if(object == voxelData && ispcEquivalent)
+    // Update the state derived from the voxels when voxelData is committed.
+    if(object == voxelData && ispcEquivalent && finished) {
+      voxelsChanged = true;
+
+      // Recompute the voxel value range unless it was provided.
+      if (computesVoxelRange()) {
+        const size_t voxelCount = (size_t)dimensions.x * (size_t)dimensions.y * (size_t)dimensions.z;
+        voxelRange = vec2f(FLT_MAX, -FLT_MAX);
+        if (voxelType == "float") computeVoxelRange((float *)voxelData->data, voxelCount);
+        if (voxelType == "uchar") computeVoxelRange((unsigned char *)voxelData->data, voxelCount);
+        set("voxelRange", voxelRange);
+      }
+
+      // Rebuild the volume accelerator, and the gradient cache if enabled.
       ispc::StructuredVolume_buildAccelerator(ispcEquivalent);
+      if (gradientCacheEnabled)
+        ispc::StructuredVolume_setGradientCache(ispcEquivalent, true);
+
+      // Recompute the histogram if requested.
+      computeHistogram();
+      voxelsChanged = false;
+
+      notifyListenersThatObjectGotChanged();
+    }
   }
 
 } // ::ospray
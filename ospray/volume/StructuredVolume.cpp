@@ -24,6 +24,13 @@
 
 namespace ospray {
 
+  StructuredVolume::~StructuredVolume()
+  {
+    // Free the gradient cache, the ISPC container itself is freed by ~ManagedObject.
+    if (ispcEquivalent != NULL && gradientCacheEnabled)
+      ispc::StructuredVolume_setGradientCache(ispcEquivalent, false);
+  }
+
   void StructuredVolume::commit()
   {
     // Some parameters can be changed after the volume has been allocated and filled.
@@ -46,13 +53,43 @@ namespace ospray {
     if (!finished) {
       finish();
       finished = true;
+      computeHistogram();
+      notifyListenersThatObjectGotChanged();
+      return;
     }
+
+    // Re-encode the acceleration structure where voxels changed since the last commit.
+    ispc::StructuredVolume_updateAccelerator(ispcEquivalent);
+
+    // setRegion() only widens the voxel value range, recompute it from the brick ranges once overwritten voxels are re-encoded.
+    vec2f range;
+    if (voxelsChanged && computesVoxelRange() && ispc::StructuredVolume_computeVoxelRange(ispcEquivalent, (ispc::vec2f &) range))
+      voxelRange = range;
+
+    // Rebuild the gradient cache if it was toggled or the voxels it was computed from changed.
+    const bool gradientCacheRequested = getParam1i("gradientCache", 0);
+    if (gradientCacheRequested != gradientCacheEnabled || (gradientCacheEnabled && voxelsChanged)) {
+      gradientCacheEnabled = gradientCacheRequested;
+      ispc::StructuredVolume_setGradientCache(ispcEquivalent, gradientCacheEnabled);
+    }
+
+    // Recompute the histogram if requested and out of date.
+    computeHistogram();
+    voxelsChanged = false;
+
+    // Make the updated voxel value range visible to the application.
+    if (!voxelRangeProvided)
+      set("voxelRange", voxelRange);
+
+    // Geometries referring to this volume (slices, isosurfaces) are finalized again with their models.
+    notifyListenersThatObjectGotChanged();
   }
 
   void StructuredVolume::finish()
   {
     // Make the voxel value range visible to the application.
-    if (findParam("voxelRange") == NULL)
+    voxelRangeProvided = findParam("voxelRange") != NULL;
+    if (!voxelRangeProvided)
       set("voxelRange", voxelRange);
     else
       voxelRange = getParam2f("voxelRange", voxelRange);
@@ -60,10 +97,54 @@ namespace ospray {
     // Build volume accelerator.
     ispc::StructuredVolume_buildAccelerator(ispcEquivalent);
 
+    // Optionally build the quantized gradient cache used for gradient shading.
+    gradientCacheEnabled = getParam1i("gradientCache", 0);
+    if (gradientCacheEnabled)
+      ispc::StructuredVolume_setGradientCache(ispcEquivalent, true);
+
     // Volume finish actions.
     Volume::finish();
   }
 
+  void StructuredVolume::markRegionDirty(const vec3i &index, const vec3i &count)
+  {
+    // Before the first commit the acceleration structure does not exist yet and will be built in full.
+    if (finished) {
+      ispc::StructuredVolume_markRegionDirty(ispcEquivalent, (const ispc::vec3i &) index, (const ispc::vec3i &) count);
+      voxelsChanged = true;
+    }
+  }
+
+  void StructuredVolume::computeHistogram()
+  {
+    // The histogram is optional.
+    const int binCount = getParam1i("histogramBinCount", 0);
+    if (binCount <= 0) { histogramBinCount = 0;  return; }
+
+    // The histogram is up to date unless the voxels or the bin count changed.
+    if (binCount == histogramBinCount && !voxelsChanged) return;
+    histogramBinCount = binCount;
+
+    // Bin the voxel values over the voxel value range in parallel.
+    Data *histogram = new Data(binCount, OSP_ULONG, NULL, 0);
+    uint64 count = 0;  double sum = 0.0, sumOfSquares = 0.0;
+    ispc::StructuredVolume_computeHistogram(ispcEquivalent, binCount, (const ispc::vec2f &) voxelRange, (uint64 *) histogram->data, count, sum, sumOfSquares);
+
+    // Make the histogram and statistics visible to the application.
+    const double mean = count ? sum / count : 0.0;
+    const double variance = count ? std::max(sumOfSquares / count - mean * mean, 0.0) : 0.0;
+    set("histogram", (ManagedObject *) histogram);
+    set("histogramRange", voxelRange);
+    set("voxelMean", float(mean));
+    set("voxelStandardDeviation", float(sqrt(variance)));
+  }
+
+  bool StructuredVolume::computesVoxelRange()
+  {
+    // After the first commit the "voxelRange" parameter holds the computed range.
+    return(finished ? !voxelRangeProvided : findParam("voxelRange") == NULL);
+  }
+
   OSPDataType StructuredVolume::getVoxelType() const
   {
     // Separate out the base type and vector width.
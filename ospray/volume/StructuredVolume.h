@@ -36,10 +36,10 @@ namespace ospray {
   public:
 
     //! Constructor.
-    StructuredVolume() : finished(false), voxelRange(FLT_MAX, -FLT_MAX) {}
+    StructuredVolume() : finished(false), voxelRangeProvided(false), gradientCacheEnabled(false), voxelsChanged(false), histogramBinCount(0), voxelRange(FLT_MAX, -FLT_MAX) {}
 
     //! Destructor.
-    virtual ~StructuredVolume() {};
+    virtual ~StructuredVolume();
 
     //! A string description of this class.
     virtual std::string toString() const { return("ospray::StructuredVolume<" + voxelType + ">"); }
@@ -58,6 +58,15 @@ namespace ospray {
     //! Complete volume initialization (only on first commit).
     virtual void finish();
 
+    //! Mark the acceleration structure covering the given voxels for update on the next commit.
+    void markRegionDirty(const vec3i &index, const vec3i &count);
+
+    //! Compute the voxel value histogram and statistics if requested through "histogramBinCount" and out of date.
+    void computeHistogram();
+
+    //! Determine if the voxel value range is to be computed from the voxel data (i.e. was not provided as a parameter).
+    bool computesVoxelRange();
+
     //! Get the OSPDataType enum corresponding to the voxel type string.
     OSPDataType getVoxelType() const;
 
@@ -79,6 +88,18 @@ namespace ospray {
     //! Indicate that the volume is fully initialized.
     bool finished;
 
+    //! Indicate that the voxel value range was provided as a parameter at the first commit.
+    bool voxelRangeProvided;
+
+    //! Indicate that the quantized gradient cache is built.
+    bool gradientCacheEnabled;
+
+    //! Indicate that voxels were modified since the last commit.
+    bool voxelsChanged;
+
+    //! Number of bins of the last computed histogram (0 if none).
+    int histogramBinCount;
+
     //! Voxel value range (will be computed if not provided as a parameter).
     vec2f voxelRange;
 
@@ -14,15 +14,27 @@
 // limitations under the License.                                           //
 // ======================================================================== //
 
+#include "ospray/volume/AMRVolume.h"
 #include "ospray/volume/BlockBrickedVolume.h"
+#include "ospray/volume/MultiResolutionVolume.h"
 #include "ospray/volume/SharedStructuredVolume.h"
+#include "ospray/volume/TimeSeriesVolume.h"
 
 namespace ospray {
 
+  // A volume type over block-structured adaptive mesh refinement data, given as bricks of cell-centered values per refinement level.
+  OSP_REGISTER_VOLUME(AMRVolume, amr_volume);
+
   // A volume type with 64-bit addressing and multi-level bricked storage order.
   OSP_REGISTER_VOLUME(BlockBrickedVolume, block_bricked_volume);
 
+  // A block bricked volume which also keeps downsampled copies of its voxel data for level of detail rendering.
+  OSP_REGISTER_VOLUME(MultiResolutionVolume, multi_resolution_volume);
+
   // A volume type with XYZ storage order. The voxel data is provided by the application via a shared data buffer.
   OSP_REGISTER_VOLUME(SharedStructuredVolume, shared_structured_volume);
 
+  // A volume type rendering the current timestep of a time-varying volume, with the voxel data of each timestep held by a separate volume.
+  OSP_REGISTER_VOLUME(TimeSeriesVolume, time_series_volume);
+
 } // ::ospray
@@ -0,0 +1,71 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+//ospray
+#include "ospray/volume/TimeSeriesVolume.h"
+#include "TimeSeriesVolume_ispc.h"
+
+namespace ospray {
+
+  void TimeSeriesVolume::commit()
+  {
+    // Create the equivalent ISPC volume container.
+    if (ispcEquivalent == NULL) createEquivalentISPC();
+
+    // Parameters applied by the renderer to the current timestep.
+    updateEditableParameters();
+
+    // The volume holding the voxel data of the current timestep.
+    Volume *timestep = (Volume *) getParamObject("timestepVolume", NULL);
+    exitOnCondition(timestep == NULL || timestep->getIE() == NULL, "no committed timestep volume specified");
+
+    // The space skipping of the timestep volume depends on the transfer function and sampling rate of the time series.
+    timestep->set("transferFunction", getParamObject("transferFunction", NULL));
+    timestep->set("samplingRate", getParam1f("samplingRate", 1.0f));
+    timestep->set("gradientShadingEnabled", getParam1i("gradientShadingEnabled", 0));
+    timestep->commit();
+
+    // The volume BVH of the model is built over the bounds of the first timestep at model commit, later timesteps must share its grid.
+    const vec3f lower = timestep->getParam3f("boundingBoxMin", vec3f(0.0f));
+    const vec3f upper = timestep->getParam3f("boundingBoxMax", vec3f(0.0f));
+    exitOnCondition(ispc::TimeSeriesVolume_hasTimestep(ispcEquivalent)
+                    && (lower != getParam3f("boundingBoxMin", lower) || upper != getParam3f("boundingBoxMax", upper)),
+                    "the bounding box of the timestep volume differs from the previous timesteps");
+
+    // Sample the timestep volume, no other state is rebuilt.
+    ispc::TimeSeriesVolume_setTimestep(ispcEquivalent, timestep->getIE());
+
+    // Make the bounding box of the current timestep visible to the application.
+    finish();
+
+    // Geometries referring to this volume are finalized again with their models.
+    notifyListenersThatObjectGotChanged();
+  }
+
+  int TimeSeriesVolume::setRegion(const void *source, const vec3i &index, const vec3i &count)
+  {
+    exitOnCondition(true, "setRegion() not allowed on this volume type; "
+                    "volume data must be provided via the timestepVolume parameter");
+    return 0;
+  }
+
+  void TimeSeriesVolume::createEquivalentISPC()
+  {
+    // Create an ISPC TimeSeriesVolume object.
+    ispcEquivalent = ispc::TimeSeriesVolume_createInstance(this);
+  }
+
+} // ::ospray
@@ -0,0 +1,58 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "ospray/volume/Volume.h"
+
+namespace ospray {
+
+  //! \brief A Volume rendering one timestep of a time-varying volume.
+  //!
+  //!  The voxel data of each timestep is held by a separate volume
+  //!  object given by the "timestepVolume" parameter.  Changing the
+  //!  timestep only redirects sampling to the new volume, leaving the
+  //!  model, the acceleration structure of each timestep volume, and
+  //!  the resident timesteps untouched.  All timesteps must share the
+  //!  bounding box of the first one, which the volume BVH of the model
+  //!  is built over.
+  //!
+  class TimeSeriesVolume : public Volume {
+  public:
+
+    //! Constructor.
+    TimeSeriesVolume() {};
+
+    //! Destructor.
+    virtual ~TimeSeriesVolume() {};
+
+    //! A string description of this class.
+    virtual std::string toString() const { return("ospray::TimeSeriesVolume"); }
+
+    //! Select the current timestep, called through the OSPRay API.
+    virtual void commit();
+
+    //! Copy voxels into the volume at the given index; not allowed on TimeSeriesVolume.
+    virtual int setRegion(const void *source, const vec3i &index, const vec3i &count);
+
+  protected:
+
+    //! Create the equivalent ISPC volume container.
+    virtual void createEquivalentISPC();
+
+  };
+
+} // ::ospray